@@ -0,0 +1,67 @@
+#!/bin/sh
+#
+# Cross-compiles the particle engine and the RNG for the watch's Cortex-M3
+# (no Pebble SDK needed), runs them on QEMU's lm3s6965evb board and reports
+# instructions executed per frame and per particle, for the float and the
+# fixed point engine. QEMU counts instructions, not cycles; on the M3 most
+# instructions take one cycle, loads, branches and divides a few more.
+#
+# Needs arm-none-eabi-gcc and qemu-system-arm built with TCG plugins. Point
+# QEMU_INSN_PLUGIN at libinsn.so if it isn't in the usual place.
+#
+set -e
+
+M3_CC=${M3_CC:-arm-none-eabi-gcc}
+QEMU_ARM=${QEMU_ARM:-qemu-system-arm}
+FRAMES=${FRAMES:-100}
+BUILD=build/m3
+NUM_PARTICLES=$(sed -n 's/^#define NUM_PARTICLES \([0-9]*\).*/\1/p' src/particle.h)
+
+if [ -z "$QEMU_INSN_PLUGIN" ]; then
+  for p in /usr/lib/qemu/plugins/libinsn.so /usr/local/lib/qemu/plugins/libinsn.so \
+           /usr/libexec/qemu/plugins/libinsn.so; do
+    [ -f "$p" ] && QEMU_INSN_PLUGIN=$p && break
+  done
+fi
+if [ -z "$QEMU_INSN_PLUGIN" ]; then
+  echo "can't find QEMU's libinsn.so plugin, set QEMU_INSN_PLUGIN" >&2
+  exit 1
+fi
+
+CFLAGS="-mcpu=cortex-m3 -mthumb -mfloat-abi=soft -O2 -std=gnu99 -Wall -ffreestanding
+        -ffunction-sections -fdata-sections -Isrc -Ihost/m3"
+LDFLAGS="-nostdlib -T host/m3/lm3s6965.ld -Wl,--gc-sections"
+SOURCES="host/m3/startup.c host/m3/bench_m3.c src/particle.c src/rng.c src/tinymt32.c"
+
+mkdir -p $BUILD
+
+# prints the instructions executed by one build of the benchmark
+count() {
+  elf=$BUILD/bench-$1-$2-$3.elf
+  $M3_CC $CFLAGS $4 -DBENCH_MODE=$2 -DBENCH_FRAMES=$3 -o $elf $SOURCES $LDFLAGS -lgcc
+  $QEMU_ARM -M lm3s6965evb -nographic -monitor none -serial none \
+    -semihosting-config enable=on,target=native \
+    -plugin $QEMU_INSN_PLUGIN,inline=on -d plugin -D $elf.log \
+    -kernel $elf > $elf.out
+  sed -n 's/^insns: \([0-9]*\).*/\1/p' $elf.log | tail -1
+}
+
+# per particle, or per random value for the refill
+printf "%-7s %-10s %14s %14s\n" engine case insns/frame insns/each
+for engine in float fixed; do
+  flags=""
+  [ $engine = fixed ] && flags="-DFIREFLIES_FIXED_POINT"
+  for mode in 0 3 1 2; do
+    each=$NUM_PARTICLES
+    case $mode in
+      0) name=swarm ;;
+      3) name=swarm-lod ;;
+      1) name=formation ;;
+      2) name=rng-refill; each=$(sed -n 's/^#define RNG_BUFFER_SIZE \([0-9]*\).*/\1/p' src/rng.h) ;;
+    esac
+    base=$(count $engine $mode 0 "$flags")
+    total=$(count $engine $mode $FRAMES "$flags")
+    per_frame=$(( (total - base) / FRAMES ))
+    printf "%-7s %-10s %14d %14d\n" $engine $name $per_frame $(( per_frame / each ))
+  done
+done
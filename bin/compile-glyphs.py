@@ -0,0 +1,153 @@
+#!/usr/bin/env python
+#
+# Compile the digit images into src/glyph_points.h.
+#
+# Reads 0.png .. 9.png (or number_0.png .. number_9.png) from a directory,
+# with nothing but the standard library. A pixel is lit when it is at least
+# half bright composited over the black watch face, which matches what
+# bitmapgen.py made of doc/glyphs for the old src/numbers.h.
+#
+# Each digit's lit pixels are written in farthest-point order: every point is
+# the lit pixel farthest from all the points before it. Any prefix of the list
+# is then spread evenly over the whole glyph, so swarm_to_digit() can hand
+# the first N points to N particles, whatever N is. display_time() puts at
+# most (NUM_PARTICLES - 5) / 3 particles on one digit, so only that many are
+# kept; `make glyph-points` passes NUM_PARTICLES in from src/particle.h.
+#
+#   python bin/compile-glyphs.py doc/glyphs 140 > src/glyph_points.h
+#
+import os
+import struct
+import sys
+import zlib
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(path):
+    """Returns (width, height, rows of (luminance, alpha)) for an 8-bit,
+    non-interlaced PNG of any colour type."""
+    data = open(path, 'rb').read()
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        raise ValueError('%s: not a PNG' % path)
+    pos = 8
+    idat = b''
+    palette = []
+    alphas = b''
+    while pos < len(data):
+        length, kind = struct.unpack('>I4s', data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b'IHDR':
+            w, h, depth, ctype, _, _, interlace = struct.unpack('>IIBBBBB', body)
+            if depth != 8 or interlace:
+                raise ValueError('%s: only 8-bit non-interlaced images' % path)
+        elif kind == b'PLTE':
+            palette = [tuple(bytearray(body[i:i + 3])) for i in range(0, len(body), 3)]
+        elif kind == b'tRNS':
+            alphas = bytearray(body)
+        elif kind == b'IDAT':
+            idat += body
+
+    bpp = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[ctype]
+    stride = w * bpp
+    raw = bytearray(zlib.decompress(idat))
+    rows = []
+    prev = bytearray(stride)
+    for y in range(h):
+        start = y * (stride + 1)
+        kind = raw[start]
+        line = raw[start + 1:start + 1 + stride]
+        for x in range(stride):
+            a = line[x - bpp] if x >= bpp else 0
+            b = prev[x]
+            c = prev[x - bpp] if x >= bpp else 0
+            if kind == 1:
+                line[x] = (line[x] + a) & 0xFF
+            elif kind == 2:
+                line[x] = (line[x] + b) & 0xFF
+            elif kind == 3:
+                line[x] = (line[x] + (a + b) // 2) & 0xFF
+            elif kind == 4:
+                line[x] = (line[x] + paeth(a, b, c)) & 0xFF
+        prev = line
+
+        pixels = []
+        for x in range(w):
+            p = line[x * bpp:(x + 1) * bpp]
+            if ctype == 0:
+                pixels.append((p[0], 255))
+            elif ctype == 4:
+                pixels.append((p[0], p[1]))
+            elif ctype == 3:
+                r, g, b = palette[p[0]]
+                alpha = alphas[p[0]] if p[0] < len(alphas) else 255
+                pixels.append(((r * 299 + g * 587 + b * 114) // 1000, alpha))
+            else:
+                alpha = p[3] if ctype == 6 else 255
+                pixels.append(((p[0] * 299 + p[1] * 587 + p[2] * 114) // 1000, alpha))
+        rows.append(pixels)
+    return w, h, rows
+
+
+def lit_pixels(path):
+    w, h, rows = read_png(path)
+    return [(x, y) for y in range(h) for x in range(w)
+            if rows[y][x][0] * rows[y][x][1] >= 127 * 255]
+
+
+def find_image(directory, digit):
+    for name in ('%d.png' % digit, 'number_%d.png' % digit):
+        path = os.path.join(directory, name)
+        if os.path.exists(path):
+            return path
+    raise IOError('no image for %d in %s' % (digit, directory))
+
+
+def farthest_point_order(points):
+    # start from the pixel nearest the centre, so even one point sits inside
+    cx = sum(p[0] for p in points) / float(len(points))
+    cy = sum(p[1] for p in points) / float(len(points))
+    first = min(points, key=lambda p: (p[0] - cx) ** 2 + (p[1] - cy) ** 2)
+    order = [first]
+    dist = dict((p, (p[0] - first[0]) ** 2 + (p[1] - first[1]) ** 2) for p in points)
+    del dist[first]
+    while dist:
+        # ties go to the earliest pixel in row order, so output is stable
+        best = max(points, key=lambda p: dist.get(p, -1))
+        order.append(best)
+        del dist[best]
+        for p in dist:
+            d = (p[0] - best[0]) ** 2 + (p[1] - best[1]) ** 2
+            if d < dist[p]:
+                dist[p] = d
+    return order
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit('usage: compile-glyphs.py <glyph directory> <NUM_PARTICLES>')
+    directory = sys.argv[1]
+    max_points = (int(sys.argv[2]) - 5) // 3
+    out = sys.stdout
+    out.write('// Generated by bin/compile-glyphs.py from %s, do not edit.\n' % directory)
+    out.write('// The first %d lit pixels of each digit in farthest-point order.\n\n' % max_points)
+    for digit in range(10):
+        points = farthest_point_order(lit_pixels(find_image(directory, digit)))[:max_points]
+        out.write('static const GlyphPixel glyph_%d_points[] = {\n' % digit)
+        for i in range(0, len(points), 8):
+            out.write('  ' + ' '.join('{%2d,%2d},' % p for p in points[i:i + 8]) + '\n')
+        out.write('};\n\n')
+    out.write('const Glyph glyphs[10] = {\n')
+    for digit in range(10):
+        out.write('  { glyph_%d_points, sizeof(glyph_%d_points) / sizeof(GlyphPixel) },\n' % (digit, digit))
+    out.write('};\n')
+
+
+if __name__ == '__main__':
+    main()
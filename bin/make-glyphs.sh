@@ -1,10 +1,9 @@
 #!/bin/sh
 #
-# Generate a .h file for the numbers based on the glyphs for a particular font.
-# Requires the (for-pay) tool GlyphDesigner CLI GDCL & (opensource) Imagemagick
-# along with Pebbles png 2 .h tools
-#
-# Update the paths below as necessary
+# Render the digit images in doc/glyphs from a font, then compile them into
+# src/glyph_points.h. Rendering requires the (for-pay) tool GlyphDesigner CLI
+# GDCL & (opensource) Imagemagick; to recompile the images that are already
+# checked in, `make glyph-points` is enough.
 #
 GLYPHS_DIR=doc/glyphs
 rm -f $GLYPHS_DIR/*.png
@@ -17,7 +16,4 @@ rm glyphs.png
 rm glyphs.txt
 popd
 
-rm -f src/numbers.h || :
-for f in `find $GLYPHS_DIR -type f -name '*.png'`; do 
-  python /Users/nmurray/programming/c/pebble/pebble-sdk-release-001/sdk/tools/bitmapgen.py header $f >> src/numbers.h 
-done
+make glyph-points GLYPHS_DIR=$GLYPHS_DIR
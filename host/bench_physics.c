@@ -0,0 +1,93 @@
+// Host benchmark for the particle engine: times update_particles() for the
+// engine this binary was built with (see `make bench-physics`), and again
+// with the swarm frames stepped by update_particles_lod().
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "particle.h"
+
+#define SWARM_FRAMES 2400
+#define FORMATION_FRAMES 240
+#define ROUNDS 20
+
+static Particles particles;
+static Rng rng;
+
+static int random_in_range(int min, int max) {
+  return rng_range(&rng, min, max);
+}
+
+static void init_particles(void) {
+  for(int i=0; i<NUM_PARTICLES; i++) {
+    init_particle(&particles, &rng, i, FPoint(random_in_range(-10, 154), random_in_range(-10, 178)),
+                  FPoint(72, 84), NORMAL_POWER);
+  }
+}
+
+// a swarm period followed by a formation period, like one minute on the watch
+static void run_minute(int lod) {
+  for(int f=0; f<SWARM_FRAMES; f++) {
+    rng_refill(&rng);
+    if(lod) {
+      update_particles_lod(&particles, &rng, 0);
+    } else {
+      update_particles(&particles, &rng, 0);
+    }
+  }
+  for(int i=0; i<NUM_PARTICLES; i++) {
+    set_particle_gravity(&particles, &rng, i, FPoint(random_in_range(25, 120), random_in_range(60, 98)), TIGHT_POWER);
+    particles.goal_size[i] = SCALAR(3.0F);
+  }
+  for(int f=0; f<FORMATION_FRAMES; f++) {
+    rng_refill(&rng);
+    if(lod) {
+      update_particles_lod(&particles, &rng, 1);
+    } else {
+      update_particles(&particles, &rng, 1);
+    }
+  }
+  for(int i=0; i<NUM_PARTICLES; i++) {
+    particles.power[i] = NORMAL_POWER;
+    particles.goal_size[i] = SCALAR(0);
+  }
+}
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void bench(const char *mode, int lod) {
+  rng_init(&rng, 4);
+  init_particles();
+  run_minute(lod); // warm up
+
+  double start = now_ns();
+  for(int r=0; r<ROUNDS; r++) run_minute(lod);
+  double elapsed = now_ns() - start;
+  long updates = (long)ROUNDS * (SWARM_FRAMES + FORMATION_FRAMES) * NUM_PARTICLES;
+
+  float mx = 0, my = 0;
+  int lit = 0;
+  for(int i=0; i<NUM_PARTICLES; i++) {
+    mx += scalar_to_float(particles.x[i]);
+    my += scalar_to_float(particles.y[i]);
+    if(scalar_to_int(particles.size[i]) > 0) lit++;
+  }
+
+#ifdef FIREFLIES_FIXED_POINT
+  const char *engine = "fixed";
+#else
+  const char *engine = "float";
+#endif
+  printf("%s%s: %ld updates, %.2f ns/particle, %.1f us/frame (mean pos %.1f,%.1f, %d lit)\n",
+         engine, mode, updates, elapsed / updates, elapsed / updates * NUM_PARTICLES / 1000.0,
+         mx / NUM_PARTICLES, my / NUM_PARTICLES, lit);
+}
+
+int main(void) {
+  bench("", 0);
+  bench(" lod", 1);
+  return 0;
+}
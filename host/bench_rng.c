@@ -0,0 +1,53 @@
+// Host benchmark for random number generation: the cost of one frame's worth
+// of draws made straight from tinymt32 as floats, against the batched Rng
+// buffer this binary was built with (see `make bench-rng`).
+#include <stdio.h>
+#include <time.h>
+#include "rng.h"
+
+// what update_particles() draws per frame on average in the simulator
+#define DRAWS_PER_FRAME 490
+#define FRAMES 200000
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(void) {
+  volatile float sink_f = 0;
+  volatile uint32_t sink_u = 0;
+
+  tinymt32_t mt;
+  tinymt32_init(&mt, 4);
+  double start = now_ns();
+  for(int f=0; f<FRAMES; f++) {
+    float acc = 0;
+    for(int d=0; d<DRAWS_PER_FRAME; d++) acc += tinymt32_generate_float01(&mt);
+    sink_f += acc;
+  }
+  double direct = (now_ns() - start) / FRAMES;
+
+  Rng rng;
+  rng_init(&rng, 4);
+  start = now_ns();
+  for(int f=0; f<FRAMES; f++) {
+    uint32_t acc = 0;
+    rng_refill(&rng);
+    for(int d=0; d<DRAWS_PER_FRAME; d++) acc += rng_next(&rng);
+    sink_u += acc;
+  }
+  double buffered = (now_ns() - start) / FRAMES;
+
+#ifdef FIREFLIES_TINYMT_RNG
+  const char *generator = "tinymt32";
+#else
+  const char *generator = "xorshift32";
+#endif
+  printf("%d draws/frame: direct tinymt32 float %.2f us/frame, buffered %s %.2f us/frame\n",
+         DRAWS_PER_FRAME, direct / 1000.0, generator, buffered / 1000.0);
+  (void)sink_f;
+  (void)sink_u;
+  return 0;
+}
@@ -0,0 +1,273 @@
+// Runs the watch face through named scenarios on the simulated clock and
+// reports, for the frames inside each scenario's measurement window, frame
+// latency percentiles (handlers plus rendering, wall clock), draw calls and
+// random values per frame, wakeups per minute, and frames and milliseconds
+// until the digits are legible.
+//
+//   fireflies-bench [-r frame_ms] [-b baseline.txt [-l]]
+//
+// -r runs every scenario at another frame interval (the watch face's
+// min_frame_ms), to compare wakeups and how fast the digits form against the
+// default rate; physics steps are fixed, so the fireflies should move the same.
+//
+// Output is one "scenario metric value" line per result. With -b the results
+// are also compared against a stored run. The deterministic metrics (frames,
+// wakeups, random values, time to legible, ...) must match exactly; those
+// differences go to stderr and make the exit status 1. Latency is wall clock
+// on whatever machine runs the bench, so p50 and p90 more than LATENCY_SLACK
+// slower are only reported, unless -l holds them to it too (p99 and the max
+// are a frame or two out of a few hundred, too noisy to hold to at all).
+//
+// Each scenario runs REPEATS times, each in its own forked process so it
+// starts from the watch face's pristine globals. The runs do identical work,
+// so the fastest of them is kept for each latency.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "sim.h"
+#include "rng.h"
+#include "formation_metric.h"
+
+#define MAX_FRAMES 8192
+#define MAX_RESULTS 128
+#define REPEATS 5
+#define LATENCY_SLACK 1.25
+#define LATENCY_FLOOR_US 2.0 // ignore changes smaller than this
+
+extern Rng rng;
+extern int min_frame_ms;
+
+typedef struct Scenario {
+  const char *name;
+  int hour, min, sec;
+  uint32_t duration_ms;
+  uint32_t measure_from_ms; // frames before this are warm-up
+  uint32_t click_every_ms;  // 0 for no back presses
+} Scenario;
+
+static const Scenario scenarios[] = {
+  // nothing but swarm timers before the first minute tick
+  { "idle_swarm",  9, 58,  0, 50000,     0,   0 },
+  // the tick at 5 s forms "9:59" and "10:59"
+  { "time_3digit", 9, 58, 55, 15000,  5000,   0 },
+  { "time_4digit", 10, 58, 55, 15000, 5000,   0 },
+  // EVENT_DISPERSE runs 12 s after the tick
+  { "dispersal",   9, 58, 55, 27000, 17000,   0 },
+  // back pressed every 150 ms; only the first forms the digits, the rest find
+  // them already up
+  { "back_spam",   9, 58,  0, 11000,  1000, 150 },
+};
+#define NUM_SCENARIOS (int)(sizeof(scenarios) / sizeof(scenarios[0]))
+
+static const Scenario *current;
+static double frame_us[MAX_FRAMES];
+static int measured_frames;
+static uint64_t draw_calls_before, random_before;
+static uint32_t wakeups_before;
+static FormationMetric formation;
+
+static uint64_t draw_calls(void) {
+  return (uint64_t)sim_stats.fill_circle_calls + sim_stats.bitmap_draw_calls;
+}
+
+static uint64_t random_values(void) {
+  return (uint64_t)rng.generated + rng.next;
+}
+
+static void measure_frame(uint32_t frame, uint32_t now_ms) {
+  if(now_ms < current->measure_from_ms) {
+    draw_calls_before = draw_calls();
+    random_before = random_values();
+    wakeups_before = sim_stats.timer_events;
+    formation.events_seen = sim_stats.tick_events + sim_stats.click_events;
+    return;
+  }
+  formation_metric_frame(&formation, frame, now_ms);
+  if(measured_frames < MAX_FRAMES) frame_us[measured_frames++] = sim_stats.frame_ns / 1e3;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+static double percentile(int p) {
+  if(measured_frames == 0) return 0.0;
+  int k = (measured_frames * p + 99) / 100 - 1;
+  return frame_us[k < 0 ? 0 : k];
+}
+
+static void run_scenario(const Scenario *scenario, FILE *out) {
+  current = scenario;
+  sim_config.start_hour = scenario->hour;
+  sim_config.start_min = scenario->min;
+  sim_config.start_sec = scenario->sec;
+  sim_config.duration_ms = scenario->duration_ms;
+  if(scenario->click_every_ms > 0) {
+    for(uint32_t t=scenario->measure_from_ms; t<=scenario->duration_ms && sim_config.num_clicks < SIM_MAX_CLICKS;
+        t+=scenario->click_every_ms) {
+      sim_config.click_times_ms[sim_config.num_clicks++] = t;
+    }
+  }
+  sim_config.on_frame = measure_frame;
+  pbl_main(NULL);
+
+  formation_metric_finish(&formation, scenario->duration_ms);
+  int frames = measured_frames ? measured_frames : 1;
+  qsort(frame_us, measured_frames, sizeof(frame_us[0]), compare_doubles);
+  fprintf(out, "%s frames %d\n", scenario->name, measured_frames);
+  fprintf(out, "%s p50_us %.2f\n", scenario->name, percentile(50));
+  fprintf(out, "%s p90_us %.2f\n", scenario->name, percentile(90));
+  fprintf(out, "%s p99_us %.2f\n", scenario->name, percentile(99));
+  fprintf(out, "%s max_us %.2f\n", scenario->name, percentile(100));
+  fprintf(out, "%s draw_calls_per_frame %.2f\n", scenario->name, (double)(draw_calls() - draw_calls_before) / frames);
+  fprintf(out, "%s random_per_frame %.2f\n", scenario->name, (double)(random_values() - random_before) / frames);
+  fprintf(out, "%s formations %u\n", scenario->name, formation.legible);
+  fprintf(out, "%s unsettled %u\n", scenario->name, formation.missed + formation.pending);
+  fprintf(out, "%s frames_to_legible %.2f\n", scenario->name,
+          formation.legible ? (double)formation.frames / formation.legible : 0.0);
+  fprintf(out, "%s ms_to_legible %.0f\n", scenario->name,
+          formation.legible ? (double)formation.ms / formation.legible : 0.0);
+  fprintf(out, "%s wakeups_per_min %.1f\n", scenario->name,
+          (sim_stats.timer_events - wakeups_before) * 60000.0 / (scenario->duration_ms - scenario->measure_from_ms));
+  fprintf(out, "%s snapshot_frames_saved %u\n", scenario->name, formation.frames_saved);
+}
+
+typedef struct Result {
+  char scenario[32];
+  char metric[32];
+  double value;
+} Result;
+
+static int parse_results(FILE *in, Result *results) {
+  int n = 0;
+  while(n < MAX_RESULTS &&
+        fscanf(in, "%31s %31s %lf", results[n].scenario, results[n].metric, &results[n].value) == 3) {
+    n++;
+  }
+  return n;
+}
+
+static bool is_latency(const char *metric) {
+  size_t len = strlen(metric);
+  return len > 3 && strcmp(metric + len - 3, "_us") == 0;
+}
+
+static bool is_gated_latency(const char *metric) {
+  return strcmp(metric, "p50_us") == 0 || strcmp(metric, "p90_us") == 0;
+}
+
+static int compare_to_baseline(const Result *results, int count, const char *path, bool gate_latency) {
+  FILE *f = fopen(path, "r");
+  if(f == NULL) {
+    perror(path);
+    return 1;
+  }
+  static Result baseline[MAX_RESULTS];
+  int baseline_count = parse_results(f, baseline);
+  fclose(f);
+
+  int failures = 0, slower = 0;
+  for(int i=0; i<count; i++) {
+    const Result *r = &results[i];
+    const Result *b = NULL;
+    for(int j=0; j<baseline_count; j++) {
+      if(strcmp(baseline[j].scenario, r->scenario) == 0 && strcmp(baseline[j].metric, r->metric) == 0) {
+        b = &baseline[j];
+      }
+    }
+    if(b == NULL) {
+      fprintf(stderr, "%s %s: not in %s\n", r->scenario, r->metric, path);
+      failures++;
+    } else if(is_latency(r->metric)) {
+      if(is_gated_latency(r->metric) && r->value > b->value * LATENCY_SLACK && r->value - b->value > LATENCY_FLOOR_US) {
+        fprintf(stderr, "%s %s: %.2f, baseline %.2f (%+.0f%%)%s\n", r->scenario, r->metric,
+                r->value, b->value, (r->value / b->value - 1) * 100, gate_latency ? "" : ", not gated");
+        if(gate_latency) failures++;
+        else slower++;
+      }
+    } else if(r->value != b->value) {
+      fprintf(stderr, "%s %s: %.2f, baseline %.2f\n", r->scenario, r->metric, r->value, b->value);
+      failures++;
+    }
+  }
+  fprintf(stderr, "%d of %d results differ from %s", failures, count, path);
+  if(slower) fprintf(stderr, ", %d latencies slower (without -l, only reported)", slower);
+  fprintf(stderr, "\n");
+  return failures ? 1 : 0;
+}
+
+int main(int argc, char **argv) {
+  const char *baseline_path = NULL;
+  bool gate_latency = false;
+  for(int i=1; i<argc; i++) {
+    if(strcmp(argv[i], "-b") == 0 && i+1 < argc) {
+      baseline_path = argv[++i];
+    } else if(strcmp(argv[i], "-r") == 0 && i+1 < argc && atoi(argv[i+1]) > 0) {
+      min_frame_ms = atoi(argv[++i]);
+    } else if(strcmp(argv[i], "-l") == 0) {
+      gate_latency = true;
+    } else {
+      fprintf(stderr, "usage: %s [-r frame_ms] [-b baseline.txt [-l]]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  // the children write their lines here and the parent reads them back
+  FILE *collected = tmpfile();
+  if(collected == NULL) {
+    perror("tmpfile");
+    return 1;
+  }
+  static Result results[MAX_RESULTS];
+  int count = 0;
+  for(int s=0; s<NUM_SCENARIOS; s++) {
+    for(int repeat=0; repeat<REPEATS; repeat++) {
+      rewind(collected);
+      if(ftruncate(fileno(collected), 0) != 0) {
+        perror("ftruncate");
+        return 1;
+      }
+      pid_t pid = fork();
+      if(pid < 0) {
+        perror("fork");
+        return 1;
+      }
+      if(pid == 0) {
+        run_scenario(&scenarios[s], collected);
+        fflush(collected);
+        _exit(0);
+      }
+      int status;
+      waitpid(pid, &status, 0);
+      if(!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        fprintf(stderr, "%s: scenario failed\n", scenarios[s].name);
+        return 1;
+      }
+
+      static Result run[MAX_RESULTS];
+      rewind(collected);
+      int n = parse_results(collected, run);
+      for(int i=0; i<n; i++) {
+        Result *r = &results[count + i];
+        if(repeat == 0) {
+          *r = run[i];
+        } else if(is_latency(r->metric)) {
+          if(run[i].value < r->value) r->value = run[i].value;
+        } else if(run[i].value != r->value) {
+          fprintf(stderr, "%s %s: %g on one run, %g on another\n", r->scenario, r->metric, r->value, run[i].value);
+          return 1;
+        }
+      }
+      if(repeat == REPEATS - 1) count += n;
+    }
+  }
+  fclose(collected);
+  for(int i=0; i<count; i++) {
+    printf("%s %s %g\n", results[i].scenario, results[i].metric, results[i].value);
+  }
+
+  return baseline_path ? compare_to_baseline(results, count, baseline_path, gate_latency) : 0;
+}
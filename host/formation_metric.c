@@ -0,0 +1,58 @@
+#include "sim.h"
+#include "particle.h"
+#include "formation_metric.h"
+
+// the watch face's own state
+extern Particles particles;
+extern int showing_time;
+extern int frame_ms;
+extern bool formation_frozen;
+
+static void count_frames_saved(FormationMetric *metric, uint32_t now_ms) {
+  if(metric->was_frozen) {
+    uint32_t missed = (now_ms - metric->last_ms) / metric->frozen_frame_ms;
+    if(missed > 1) metric->frames_saved += missed - 1;
+  }
+  if(formation_frozen && !metric->was_frozen) metric->freezes++;
+  metric->last_ms = now_ms;
+  metric->was_frozen = formation_frozen;
+  metric->frozen_frame_ms = frame_ms;
+}
+
+void formation_metric_frame(FormationMetric *metric, uint32_t frame, uint32_t now_ms) {
+  count_frames_saved(metric, now_ms);
+  uint32_t events = sim_stats.tick_events + sim_stats.click_events;
+  if(events != metric->events_seen) {
+    metric->events_seen = events;
+    if(metric->pending) metric->missed++;
+    metric->pending = true;
+    metric->start_frame = frame;
+    metric->start_ms = now_ms;
+  }
+  if(!metric->pending) return;
+  if(!showing_time) {
+    metric->missed++;
+    metric->pending = false;
+    return;
+  }
+
+  int members = 0, close = 0;
+  for(int i=0; i<NUM_PARTICLES; i++) {
+    if(particles.power[i] != TIGHT_POWER) continue;
+    float dx = scalar_to_float(particles.x[i] - particles.grav_x[i]);
+    float dy = scalar_to_float(particles.y[i] - particles.grav_y[i]);
+    members++;
+    if(dx*dx + dy*dy <= 4.0F) close++;
+  }
+  if(members > 0 && close * 20 >= members * 19) {
+    metric->legible++;
+    metric->frames += frame - metric->start_frame;
+    metric->ms += now_ms - metric->start_ms;
+    metric->pending = false;
+  }
+}
+
+void formation_metric_finish(FormationMetric *metric, uint32_t now_ms) {
+  // as if a frame were drawn one interval after the end
+  count_frames_saved(metric, now_ms + metric->frozen_frame_ms);
+}
@@ -0,0 +1,33 @@
+#ifndef FORMATION_METRIC_H
+#define FORMATION_METRIC_H
+
+// Frames from a minute tick or back press until 95% of the particles pulled
+// into formation are within 2 px of their targets, and the frames the
+// settled-formation snapshot saved: the ones the animation would have drawn
+// at its frame interval while it was frozen instead. Call
+// formation_metric_frame() after every rendered frame.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct FormationMetric {
+  uint32_t start_frame;
+  uint32_t start_ms;
+  uint32_t events_seen;
+  bool pending;
+  uint32_t legible;  // formations that got there
+  uint32_t missed;   // interrupted or dispersed first
+  uint64_t frames;   // summed over the legible ones
+  uint64_t ms;       // likewise; comparable across frame rates
+  uint32_t last_ms;
+  bool was_frozen;
+  int frozen_frame_ms;
+  uint32_t frames_saved;
+  uint32_t freezes;  // times a formation froze
+} FormationMetric;
+
+void formation_metric_frame(FormationMetric *metric, uint32_t frame, uint32_t now_ms);
+// counts the frames saved by a formation still frozen when the run ends
+void formation_metric_finish(FormationMetric *metric, uint32_t now_ms);
+
+#endif
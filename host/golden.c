@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+#include "golden.h"
+
+#define MAX_GOLDENS 256
+
+typedef struct Golden {
+  uint32_t frame;
+  uint64_t hash;
+  bool seen;
+} Golden;
+
+static const char *golden_dir;
+static bool writing;
+static int budget;
+static uint32_t limit;
+static Golden goldens[MAX_GOLDENS];
+static int golden_count;
+static int failures;
+static int worst_diff;
+
+// FNV-1a
+static uint64_t hash_framebuffer(void) {
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for(size_t i=0; i<sizeof(sim_framebuffer); i++) {
+    h ^= sim_framebuffer[i];
+    h *= 0x100000001b3ULL;
+  }
+  return h;
+}
+
+static void frame_path(char *path, size_t size, uint32_t frame) {
+  snprintf(path, size, "%s/frame-%05u.pbm", golden_dir, frame);
+}
+
+// binary PBM: rows of bytes, most significant bit leftmost, 1 is black
+static void write_frame(uint32_t frame) {
+  char path[512];
+  frame_path(path, sizeof(path), frame);
+  FILE *f = fopen(path, "wb");
+  if(f == NULL) {
+    perror(path);
+    exit(1);
+  }
+  fprintf(f, "P4\n%d %d\n", SCREEN_WIDTH, SCREEN_HEIGHT);
+  for(int y=0; y<SCREEN_HEIGHT; y++) {
+    for(int x=0; x<SCREEN_WIDTH; x+=8) {
+      uint8_t byte = 0;
+      for(int b=0; b<8; b++) {
+        if(!sim_get_pixel(x + b, y)) byte |= 0x80 >> b;
+      }
+      fputc(byte, f);
+    }
+  }
+  fclose(f);
+}
+
+// pixels that differ from the stored frame, or -1 if it can't be read
+static int diff_frame(uint32_t frame) {
+  char path[512];
+  frame_path(path, sizeof(path), frame);
+  FILE *f = fopen(path, "rb");
+  if(f == NULL) return -1;
+  int w, h;
+  if(fscanf(f, "P4 %d %d", &w, &h) != 2 || w != SCREEN_WIDTH || h != SCREEN_HEIGHT || fgetc(f) == EOF) {
+    fclose(f);
+    return -1;
+  }
+  int diff = 0;
+  for(int y=0; y<SCREEN_HEIGHT; y++) {
+    for(int x=0; x<SCREEN_WIDTH; x+=8) {
+      int byte = fgetc(f);
+      if(byte == EOF) {
+        fclose(f);
+        return -1;
+      }
+      for(int b=0; b<8; b++) {
+        bool golden_white = !(byte & (0x80 >> b));
+        if(golden_white != sim_get_pixel(x + b, y)) diff++;
+      }
+    }
+  }
+  fclose(f);
+  return diff;
+}
+
+static bool is_checkpoint(uint32_t frame) {
+  return frame % (frame <= GOLDEN_EARLY ? GOLDEN_EARLY_EVERY : GOLDEN_EVERY) == 0;
+}
+
+void golden_init(const char *dir, bool write, int pixel_budget, uint32_t frame_limit) {
+  golden_dir = dir;
+  writing = write;
+  budget = pixel_budget;
+  limit = frame_limit;
+  if(writing) return;
+
+  char path[512];
+  snprintf(path, sizeof(path), "%s/manifest", dir);
+  FILE *f = fopen(path, "r");
+  if(f == NULL) {
+    perror(path);
+    exit(1);
+  }
+  unsigned long long hash;
+  while(golden_count < MAX_GOLDENS &&
+        fscanf(f, "%u %llx", &goldens[golden_count].frame, &hash) == 2) {
+    if(limit && goldens[golden_count].frame > limit) continue;
+    goldens[golden_count++].hash = hash;
+  }
+  fclose(f);
+}
+
+void golden_frame(uint32_t frame) {
+  if(golden_dir == NULL) return;
+  if(writing) {
+    if(!is_checkpoint(frame) || golden_count == MAX_GOLDENS) return;
+    goldens[golden_count++] = (Golden){ frame, hash_framebuffer(), true };
+    write_frame(frame);
+    return;
+  }
+
+  for(int i=0; i<golden_count; i++) {
+    Golden *g = &goldens[i];
+    if(g->frame != frame) continue;
+    g->seen = true;
+    if(hash_framebuffer() == g->hash) return;
+    int diff = diff_frame(frame);
+    if(diff > worst_diff) worst_diff = diff;
+    if(diff < 0 || diff > budget) {
+      failures++;
+      if(diff < 0) {
+        printf("golden      frame %u: hash differs and the stored frame can't be read\n", frame);
+      } else {
+        printf("golden      frame %u: %d pixels differ, budget %d\n", frame, diff, budget);
+      }
+    }
+  }
+}
+
+int golden_finish(void) {
+  if(golden_dir == NULL) return 0;
+  if(writing) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/manifest", golden_dir);
+    FILE *f = fopen(path, "w");
+    if(f == NULL) {
+      perror(path);
+      exit(1);
+    }
+    for(int i=0; i<golden_count; i++) {
+      fprintf(f, "%u %016llx\n", goldens[i].frame, (unsigned long long)goldens[i].hash);
+    }
+    fclose(f);
+    printf("golden      %d frames written to %s\n", golden_count, golden_dir);
+    return 0;
+  }
+
+  for(int i=0; i<golden_count; i++) {
+    if(!goldens[i].seen) {
+      printf("golden      frame %u: never rendered\n", goldens[i].frame);
+      failures++;
+    }
+  }
+  printf("golden      %d of %d frames match %s (worst %d pixels off, budget %d)\n",
+         golden_count - failures, golden_count, golden_dir, worst_diff, budget);
+  return failures;
+}
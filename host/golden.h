@@ -0,0 +1,26 @@
+#ifndef GOLDEN_H
+#define GOLDEN_H
+
+// Golden frames: every GOLDEN_EARLY_EVERY frames up to GOLDEN_EARLY, then
+// every GOLDEN_EVERY frames, the simulator hashes the 1bpp framebuffer and
+// either stores it (hash in DIR/manifest, the frame itself in
+// DIR/frame-NNNNN.pbm) or checks it against what was stored. With a pixel
+// budget a frame that hashes differently still passes while no more than that
+// many pixels differ, for engines that are only meant to be close, like the
+// fixed point one. Those only stay close for a while (see src/fixed.h), which
+// is what the dense early frames and the frame limit are for.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define GOLDEN_EARLY 150
+#define GOLDEN_EARLY_EVERY 25
+#define GOLDEN_EVERY 150
+
+// frame_limit: when checking, ignore stored frames after it (0 for none)
+void golden_init(const char *dir, bool write, int pixel_budget, uint32_t frame_limit);
+void golden_frame(uint32_t frame);
+// prints a line per failing frame and a summary, returns the failures
+int golden_finish(void);
+
+#endif
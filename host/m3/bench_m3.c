@@ -0,0 +1,77 @@
+// Cortex-M3 benchmark for the particle engine and the RNG, run bare metal
+// under qemu-system-arm by bin/bench-m3.sh. QEMU does not model cycles, so
+// the script counts executed instructions with QEMU's insn plugin and runs
+// each case twice, with BENCH_FRAMES frames and with none, so that the setup
+// cancels out.
+//
+//   BENCH_MODE 0: swarm frames (update_particles with showing_time 0)
+//   BENCH_MODE 1: formation frames (every particle at TIGHT_POWER)
+//   BENCH_MODE 2: refilling the whole random number buffer
+//   BENCH_MODE 3: swarm frames stepped by update_particles_lod()
+#include "particle.h"
+#include "semihost.h"
+
+#ifndef BENCH_MODE
+#define BENCH_MODE 0
+#endif
+#ifndef BENCH_FRAMES
+#define BENCH_FRAMES 100
+#endif
+#define WARMUP_FRAMES 50
+
+static Particles particles;
+static Rng rng;
+
+static void setup(void) {
+  rng_init(&rng, 4);
+  for(int i=0; i<NUM_PARTICLES; i++) {
+    init_particle(&particles, &rng, i, FPoint(rng_range(&rng, -10, 154), rng_range(&rng, -10, 178)),
+                  FPoint(72, 84), NORMAL_POWER);
+  }
+  for(int f=0; f<WARMUP_FRAMES; f++) {
+    rng_refill(&rng);
+    update_particles(&particles, &rng, 0);
+  }
+#if BENCH_MODE == 1
+  for(int i=0; i<NUM_PARTICLES; i++) {
+    set_particle_gravity(&particles, i, FPoint(rng_range(&rng, 25, 120), rng_range(&rng, 60, 98)), TIGHT_POWER);
+    particles.goal_size[i] = SCALAR(3.0F);
+  }
+#endif
+}
+
+static void run_frame(void) {
+#if BENCH_MODE == 2
+  rng.next = RNG_BUFFER_SIZE;
+  rng_refill(&rng);
+#elif BENCH_MODE == 3
+  rng_refill(&rng);
+  update_particles_lod(&particles, &rng, 0);
+#else
+  rng_refill(&rng);
+  update_particles(&particles, &rng, BENCH_MODE == 1);
+#endif
+}
+
+// the result is printed so none of the work can be optimised away
+static void write_hex(uint32_t v) {
+  char s[12] = "0x";
+  for(int i=0; i<8; i++) s[2 + i] = "0123456789abcdef"[(v >> (28 - 4 * i)) & 0xF];
+  s[10] = '\n';
+  s[11] = 0;
+  semihost_write(s);
+}
+
+int main(void) {
+  setup();
+  for(int f=0; f<BENCH_FRAMES; f++) run_frame();
+
+  uint32_t checksum = rng.values[0];
+  for(int i=0; i<NUM_PARTICLES; i++) {
+    checksum = checksum * 31 + (uint32_t)scalar_to_int(particles.x[i] * 16);
+    checksum = checksum * 31 + (uint32_t)scalar_to_int(particles.y[i] * 16);
+  }
+  semihost_write("checksum ");
+  write_hex(checksum);
+  return 0;
+}
@@ -0,0 +1,8 @@
+#ifndef SEMIHOST_H
+#define SEMIHOST_H
+
+// ARM semihosting, serviced by QEMU when run with -semihosting
+void semihost_write(const char *s);
+void semihost_exit(int status);
+
+#endif
@@ -0,0 +1,64 @@
+// Just enough of a Cortex-M3 runtime to run the benchmark under
+// qemu-system-arm: a vector table, .data/.bss setup, and semihosting calls
+// for output and for exiting QEMU when main() returns.
+#include <stdint.h>
+#include "semihost.h"
+
+extern uint32_t _etext, _sdata, _edata, _sbss, _ebss, _stack_top;
+int main(void);
+void reset_handler(void);
+
+static void hang(void) {
+  while(1);
+}
+
+__attribute__((section(".vectors"), used))
+static const void *vectors[16] = {
+  &_stack_top,
+  reset_handler,
+  hang, // NMI
+  hang, // HardFault
+  hang, // MemManage
+  hang, // BusFault
+  hang, // UsageFault
+};
+
+static int semihost_call(int op, const void *arg) {
+  register int r0 __asm__("r0") = op;
+  register const void *r1 __asm__("r1") = arg;
+  __asm__ volatile("bkpt 0xab" : "+r"(r0) : "r"(r1) : "memory");
+  return r0;
+}
+
+void semihost_write(const char *s) {
+  semihost_call(0x04, s); // SYS_WRITE0
+}
+
+void semihost_exit(int status) {
+  // SYS_EXIT with ADP_Stopped_ApplicationExit; the status only gets through
+  // on 64-bit hosts, so a failure is also reported on the console
+  if(status != 0) semihost_write("exit with failure\n");
+  semihost_call(0x18, (const void *)0x20026);
+  hang();
+}
+
+void reset_handler(void) {
+  uint32_t *src = &_etext;
+  for(uint32_t *dst = &_sdata; dst < &_edata; ) *dst++ = *src++;
+  for(uint32_t *dst = &_sbss; dst < &_ebss; ) *dst++ = 0;
+  semihost_exit(main());
+}
+
+// the compiler may call these for struct copies and clears
+void *memcpy(void *dst, const void *src, unsigned int n) {
+  uint8_t *d = dst;
+  const uint8_t *s = src;
+  while(n--) *d++ = *s++;
+  return dst;
+}
+
+void *memset(void *dst, int c, unsigned int n) {
+  uint8_t *d = dst;
+  while(n--) *d++ = (uint8_t)c;
+  return dst;
+}
@@ -0,0 +1,44 @@
+#ifndef PEBBLE_APP_H
+#define PEBBLE_APP_H
+
+// Host stand-in for the Pebble SDK 1.x pebble_app.h: app handlers, timers and
+// the event loop, driven by the simulated clock in host/pebble_shim.c.
+
+#include "pebble_os.h"
+
+typedef void *AppContextRef;
+typedef uint32_t AppTimerHandle;
+
+typedef struct PebbleTickEvent {
+  PblTm *tick_time;
+  TimeUnits units_changed;
+} PebbleTickEvent;
+
+typedef void (*PebbleAppInitEventHandler)(AppContextRef ctx);
+typedef void (*PebbleAppDeinitEventHandler)(AppContextRef ctx);
+typedef void (*PebbleAppTimerHandler)(AppContextRef ctx, AppTimerHandle handle, uint32_t cookie);
+typedef void (*PebbleAppTickHandler)(AppContextRef ctx, PebbleTickEvent *event);
+
+typedef struct PebbleAppTickInfo {
+  PebbleAppTickHandler tick_handler;
+  TimeUnits tick_units;
+} PebbleAppTickInfo;
+
+typedef struct PebbleAppHandlers {
+  PebbleAppInitEventHandler init_handler;
+  PebbleAppDeinitEventHandler deinit_handler;
+  PebbleAppTimerHandler timer_handler;
+  PebbleAppTickInfo tick_info;
+} PebbleAppHandlers;
+
+// the app metadata only matters to the watch's app loader
+#define PBL_APP_INFO(uuid, name, company, major, minor, icon, flags)
+#define APP_INFO_WATCH_FACE 1
+#define RESOURCE_ID_IMAGE_MENU_ICON 1
+
+void pbl_main(void *params);
+void app_event_loop(AppContextRef app_task_ctx, PebbleAppHandlers *handlers);
+AppTimerHandle app_timer_send_event(AppContextRef app_ctx, uint32_t timeout_ms, uint32_t cookie);
+bool app_timer_cancel_event(AppContextRef app_ctx, AppTimerHandle handle);
+
+#endif
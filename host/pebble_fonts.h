@@ -0,0 +1,9 @@
+#ifndef PEBBLE_FONTS_H
+#define PEBBLE_FONTS_H
+
+// Host stand-in for the Pebble SDK 1.x pebble_fonts.h.
+
+#define FONT_KEY_GOTHIC_14 "RESOURCE_ID_GOTHIC_14"
+#define FONT_KEY_GOTHIC_18 "RESOURCE_ID_GOTHIC_18"
+
+#endif
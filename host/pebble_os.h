@@ -0,0 +1,169 @@
+#ifndef PEBBLE_OS_H
+#define PEBBLE_OS_H
+
+// Host stand-in for the Pebble SDK 1.x pebble_os.h. Only the parts of the API
+// the watch face uses are here; they are implemented by host/pebble_shim.c on
+// top of a software 1bpp framebuffer and a simulated clock.
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct GPoint {
+  int16_t x;
+  int16_t y;
+} GPoint;
+#define GPoint(x, y) ((GPoint){(x), (y)})
+
+typedef struct GSize {
+  int16_t w;
+  int16_t h;
+} GSize;
+#define GSize(w, h) ((GSize){(w), (h)})
+
+typedef struct GRect {
+  GPoint origin;
+  GSize size;
+} GRect;
+#define GRect(x, y, w, h) ((GRect){{(x), (y)}, {(w), (h)}})
+
+typedef enum GColor {
+  GColorClear = ~0,
+  GColorBlack = 0,
+  GColorWhite = 1,
+} GColor;
+
+typedef enum {
+  GCompOpAssign,
+  GCompOpAssignInverted,
+  GCompOpOr,
+  GCompOpAnd,
+  GCompOpClear,
+} GCompOp;
+
+typedef struct GBitmap {
+  void *addr;
+  uint16_t row_size_bytes;
+  uint16_t info_flags;
+  GRect bounds;
+} GBitmap;
+
+typedef struct GContext GContext;
+typedef void *GFont;
+
+struct Layer;
+struct Window;
+typedef void (*LayerUpdateProc)(struct Layer *layer, GContext *ctx);
+
+typedef struct Layer {
+  GRect bounds;
+  GRect frame;
+  bool clips : 1;
+  bool hidden : 1;
+  struct Layer *next_sibling;
+  struct Layer *parent;
+  struct Layer *first_child;
+  struct Window *window;
+  LayerUpdateProc update_proc;
+} Layer;
+
+typedef void *ClickRecognizerRef;
+typedef void (*ClickHandler)(ClickRecognizerRef recognizer, void *context);
+
+typedef enum {
+  BUTTON_ID_BACK = 0,
+  BUTTON_ID_UP,
+  BUTTON_ID_SELECT,
+  BUTTON_ID_DOWN,
+  NUM_BUTTONS
+} ButtonId;
+
+typedef struct ClickConfig {
+  void *context;
+  struct {
+    ClickHandler handler;
+    uint16_t repeat_interval_ms;
+  } click;
+  struct {
+    ClickHandler handler;
+    ClickHandler release_handler;
+    uint16_t delay_ms;
+  } long_click;
+} ClickConfig;
+
+typedef void (*ClickConfigProvider)(ClickConfig **config, void *context);
+
+typedef struct Window {
+  Layer layer;
+  const char *debug_name;
+  GColor background_color;
+  ClickConfigProvider click_config_provider;
+  void *click_config_context;
+} Window;
+
+typedef struct TextLayer {
+  Layer layer;
+  const char *text;
+  GFont font;
+  GColor text_color;
+  GColor background_color;
+} TextLayer;
+
+typedef struct PblTm {
+  int tm_sec;
+  int tm_min;
+  int tm_hour;
+  int tm_mday;
+  int tm_mon;
+  int tm_year;
+  int tm_wday;
+  int tm_yday;
+  int tm_isdst;
+} PblTm;
+
+typedef enum {
+  SECOND_UNIT = 1 << 0,
+  MINUTE_UNIT = 1 << 1,
+  HOUR_UNIT = 1 << 2,
+  DAY_UNIT = 1 << 3,
+  MONTH_UNIT = 1 << 4,
+  YEAR_UNIT = 1 << 5,
+} TimeUnits;
+
+// graphics
+void graphics_context_set_stroke_color(GContext *ctx, GColor color);
+void graphics_context_set_fill_color(GContext *ctx, GColor color);
+void graphics_context_set_compositing_mode(GContext *ctx, GCompOp mode);
+void graphics_draw_pixel(GContext *ctx, GPoint point);
+void graphics_fill_rect(GContext *ctx, GRect rect, uint8_t corner_radius, uint8_t corner_mask);
+void graphics_fill_circle(GContext *ctx, GPoint p, uint16_t radius);
+void graphics_draw_bitmap_in_rect(GContext *ctx, const GBitmap *bitmap, GRect rect);
+
+// layers and windows
+void layer_init(Layer *layer, GRect frame);
+void layer_add_child(Layer *parent, Layer *child);
+void layer_mark_dirty(Layer *layer);
+void layer_set_frame(Layer *layer, GRect frame);
+GRect layer_get_frame(Layer *layer);
+void layer_set_hidden(Layer *layer, bool hidden);
+
+void text_layer_init(TextLayer *text_layer, GRect frame);
+void text_layer_set_text(TextLayer *text_layer, const char *text);
+const char *text_layer_get_text(TextLayer *text_layer);
+void text_layer_set_text_color(TextLayer *text_layer, GColor color);
+void text_layer_set_background_color(TextLayer *text_layer, GColor color);
+void text_layer_set_font(TextLayer *text_layer, GFont font);
+
+void window_init(Window *window, const char *debug_name);
+void window_stack_push(Window *window, bool animated);
+void window_set_background_color(Window *window, GColor background_color);
+void window_set_click_config_provider(Window *window, ClickConfigProvider click_config_provider);
+
+GFont fonts_get_system_font(const char *font_key);
+
+// time
+void get_time(PblTm *time);
+bool clock_is_24h_style(void);
+
+#endif
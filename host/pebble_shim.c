@@ -0,0 +1,564 @@
+// Software implementation of the Pebble SDK 1.x calls used by the watch face,
+// see host/sim.h.
+#include <stdio.h>
+#include <time.h>
+#include "sim.h"
+#include "clock.h"
+
+#define MAX_TIMERS 64
+#define minimum_int(a, b) ((a) < (b) ? (a) : (b))
+#define maximum_int(a, b) ((a) > (b) ? (a) : (b))
+
+struct GContext {
+  GColor stroke_color;
+  GColor fill_color;
+  GCompOp compositing_mode;
+  GPoint offset; // screen position of the layer being drawn
+  GRect clip;    // in screen coordinates
+};
+
+typedef struct SimTimer {
+  AppTimerHandle handle;
+  uint32_t deadline_ms;
+  uint32_t cookie;
+  bool active;
+} SimTimer;
+
+SimConfig sim_config = {
+  .duration_ms = 10 * 60 * 1000,
+  .start_hour = 9,
+  .start_min = 58,
+};
+SimStats sim_stats;
+uint8_t sim_framebuffer[FRAMEBUFFER_ROW_BYTES * SCREEN_HEIGHT];
+
+static uint32_t now_ms;
+static int replayed_ticks;
+static SimTimer timers[MAX_TIMERS];
+static AppTimerHandle next_timer_handle = 1;
+static Window *top_window;
+static GRect dirty_rect; // screen coordinates, empty when nothing to render
+static bool app_frame_dirty; // not just text layers
+static uint64_t handler_ns_since_frame;
+static ClickConfig click_configs[NUM_BUTTONS];
+
+uint32_t sim_now_ms(void) {
+  return now_ms;
+}
+
+uint64_t sim_wall_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// graphics
+
+bool sim_get_pixel(int x, int y) {
+  return sim_framebuffer[y * FRAMEBUFFER_ROW_BYTES + x / 8] & (1 << (x % 8));
+}
+
+static void put_pixel(GContext *ctx, int x, int y, GColor color) {
+  if(color == GColorClear) return;
+  if(x < ctx->clip.origin.x || x >= ctx->clip.origin.x + ctx->clip.size.w) return;
+  if(y < ctx->clip.origin.y || y >= ctx->clip.origin.y + ctx->clip.size.h) return;
+  uint8_t *byte = &sim_framebuffer[y * FRAMEBUFFER_ROW_BYTES + x / 8];
+  uint8_t mask = 1 << (x % 8);
+  if(color == GColorWhite) *byte |= mask; else *byte &= ~mask;
+  sim_stats.pixels_touched++;
+}
+
+void graphics_context_set_stroke_color(GContext *ctx, GColor color) {
+  ctx->stroke_color = color;
+}
+
+void graphics_context_set_fill_color(GContext *ctx, GColor color) {
+  ctx->fill_color = color;
+}
+
+void graphics_context_set_compositing_mode(GContext *ctx, GCompOp mode) {
+  ctx->compositing_mode = mode;
+}
+
+void graphics_draw_pixel(GContext *ctx, GPoint point) {
+  put_pixel(ctx, ctx->offset.x + point.x, ctx->offset.y + point.y, ctx->stroke_color);
+}
+
+static void fill_span(GContext *ctx, int y, int x0, int x1, GColor color) {
+  if(color == GColorClear) return;
+  if(y < ctx->clip.origin.y || y >= ctx->clip.origin.y + ctx->clip.size.h) return;
+  x0 = maximum_int(x0, ctx->clip.origin.x);
+  x1 = minimum_int(x1, ctx->clip.origin.x + ctx->clip.size.w);
+  for(int x=x0; x<x1; ) {
+    uint8_t *byte = &sim_framebuffer[y * FRAMEBUFFER_ROW_BYTES + x / 8];
+    int n = minimum_int(8 - x % 8, x1 - x);
+    uint8_t mask = (uint8_t)(((1 << n) - 1) << (x % 8));
+    if(color == GColorWhite) *byte |= mask; else *byte &= ~mask;
+    x += n;
+  }
+  if(x1 > x0) sim_stats.pixels_touched += x1 - x0;
+}
+
+void graphics_fill_rect(GContext *ctx, GRect rect, uint8_t corner_radius, uint8_t corner_mask) {
+  (void)corner_radius;
+  (void)corner_mask;
+  int x = ctx->offset.x + rect.origin.x;
+  for(int y=rect.origin.y; y<rect.origin.y+rect.size.h; y++) {
+    fill_span(ctx, ctx->offset.y + y, x, x + rect.size.w, ctx->fill_color);
+  }
+}
+
+// A zero radius draws nothing; otherwise every pixel whose centre is within
+// r + 1/2 of the centre is filled, which gives the usual blobby small circles.
+void graphics_fill_circle(GContext *ctx, GPoint p, uint16_t radius) {
+  sim_stats.fill_circle_calls++;
+  int r = radius;
+  if(r == 0) return;
+  for(int dy=-r; dy<=r; dy++) {
+    for(int dx=-r; dx<=r; dx++) {
+      if(dx*dx + dy*dy <= r*r + r) {
+        put_pixel(ctx, ctx->offset.x + p.x + dx, ctx->offset.y + p.y + dy, ctx->fill_color);
+      }
+    }
+  }
+}
+
+void graphics_draw_bitmap_in_rect(GContext *ctx, const GBitmap *bitmap, GRect rect) {
+  const uint8_t *bits = bitmap->addr;
+  sim_stats.bitmap_draw_calls++;
+  // clip the destination, in screen coordinates, and find where that starts
+  // in the bitmap
+  int dx0 = maximum_int(ctx->offset.x + rect.origin.x, ctx->clip.origin.x);
+  int dy0 = maximum_int(ctx->offset.y + rect.origin.y, ctx->clip.origin.y);
+  int dx1 = minimum_int(ctx->offset.x + rect.origin.x + minimum_int(rect.size.w, bitmap->bounds.size.w),
+                        ctx->clip.origin.x + ctx->clip.size.w);
+  int dy1 = minimum_int(ctx->offset.y + rect.origin.y + minimum_int(rect.size.h, bitmap->bounds.size.h),
+                        ctx->clip.origin.y + ctx->clip.size.h);
+  int sx0 = bitmap->bounds.origin.x + dx0 - (ctx->offset.x + rect.origin.x);
+  int sy0 = bitmap->bounds.origin.y + dy0 - (ctx->offset.y + rect.origin.y);
+
+  for(int y=dy0; y<dy1; y++) {
+    const uint8_t *src_row = &bits[(sy0 + y - dy0) * bitmap->row_size_bytes];
+    uint8_t *dst_row = &sim_framebuffer[y * FRAMEBUFFER_ROW_BYTES];
+    int x = dx0;
+    int sx = sx0;
+    // byte at a time when source and destination line up, like the firmware
+    if(ctx->compositing_mode == GCompOpOr && (sx - x) % 8 == 0) {
+      while(x < dx1) {
+        int n = minimum_int(8 - x % 8, dx1 - x);
+        uint8_t mask = (uint8_t)(((1 << n) - 1) << (x % 8));
+        dst_row[x / 8] |= src_row[sx / 8] & mask;
+        x += n;
+        sx += n;
+      }
+      sim_stats.pixels_touched += dx1 - dx0;
+      continue;
+    }
+    for(; x<dx1; x++, sx++) {
+      bool set = src_row[sx / 8] & (1 << (sx % 8));
+      switch(ctx->compositing_mode) {
+        case GCompOpAssign: put_pixel(ctx, x, y, set ? GColorWhite : GColorBlack); break;
+        case GCompOpAssignInverted: put_pixel(ctx, x, y, set ? GColorBlack : GColorWhite); break;
+        case GCompOpOr: if(set) put_pixel(ctx, x, y, GColorWhite); break;
+        case GCompOpAnd: if(!set) put_pixel(ctx, x, y, GColorBlack); break;
+        case GCompOpClear: if(set) put_pixel(ctx, x, y, GColorBlack); break;
+      }
+    }
+  }
+}
+
+// layers
+
+void layer_init(Layer *layer, GRect frame) {
+  memset(layer, 0, sizeof(*layer));
+  layer->frame = frame;
+  layer->bounds = GRect(0, 0, frame.size.w, frame.size.h);
+  layer->clips = true;
+}
+
+void layer_add_child(Layer *parent, Layer *child) {
+  child->parent = parent;
+  child->window = parent->window;
+  child->next_sibling = NULL;
+  if(parent->first_child == NULL) {
+    parent->first_child = child;
+  } else {
+    Layer *sibling = parent->first_child;
+    while(sibling->next_sibling) sibling = sibling->next_sibling;
+    sibling->next_sibling = child;
+  }
+  layer_mark_dirty(child);
+}
+
+static GRect rect_union(GRect a, GRect b) {
+  if(a.size.w <= 0 || a.size.h <= 0) return b;
+  if(b.size.w <= 0 || b.size.h <= 0) return a;
+  int x0 = minimum_int(a.origin.x, b.origin.x);
+  int y0 = minimum_int(a.origin.y, b.origin.y);
+  int x1 = maximum_int(a.origin.x + a.size.w, b.origin.x + b.size.w);
+  int y1 = maximum_int(a.origin.y + a.size.h, b.origin.y + b.size.h);
+  return GRect(x0, y0, x1 - x0, y1 - y0);
+}
+
+static void text_layer_update_proc(Layer *layer, GContext *ctx);
+
+// Only the union of the frames marked dirty since the last frame is cleared
+// and redrawn, the way a compositor with partial updates would. A render
+// only counts as one of the app's frames if something other than a text
+// layer asked for it: debug builds redraw their text on their own schedule.
+void layer_mark_dirty(Layer *layer) {
+  GRect frame = layer->frame;
+  for(Layer *parent=layer->parent; parent; parent=parent->parent) {
+    frame.origin.x += parent->frame.origin.x;
+    frame.origin.y += parent->frame.origin.y;
+  }
+  dirty_rect = rect_union(dirty_rect, frame);
+  if(layer->update_proc != text_layer_update_proc) app_frame_dirty = true;
+}
+
+void layer_set_frame(Layer *layer, GRect frame) {
+  layer_mark_dirty(layer);
+  layer->frame = frame;
+  layer->bounds.size = frame.size;
+  layer_mark_dirty(layer);
+}
+
+GRect layer_get_frame(Layer *layer) {
+  return layer->frame;
+}
+
+void layer_set_hidden(Layer *layer, bool hidden) {
+  layer->hidden = hidden;
+  layer_mark_dirty(layer);
+}
+
+static void text_layer_update_proc(Layer *layer, GContext *ctx) {
+  // no fonts on the host: only the background is drawn
+  TextLayer *text_layer = (TextLayer *)layer;
+  if(text_layer->background_color != GColorClear) {
+    graphics_context_set_fill_color(ctx, text_layer->background_color);
+    graphics_fill_rect(ctx, layer->bounds, 0, 0);
+  }
+}
+
+void text_layer_init(TextLayer *text_layer, GRect frame) {
+  memset(text_layer, 0, sizeof(*text_layer));
+  layer_init(&text_layer->layer, frame);
+  text_layer->layer.update_proc = text_layer_update_proc;
+  text_layer->text_color = GColorBlack;
+  text_layer->background_color = GColorWhite;
+}
+
+void text_layer_set_text(TextLayer *text_layer, const char *text) {
+  text_layer->text = text;
+  layer_mark_dirty(&text_layer->layer);
+}
+
+const char *text_layer_get_text(TextLayer *text_layer) {
+  return text_layer->text;
+}
+
+void text_layer_set_text_color(TextLayer *text_layer, GColor color) {
+  text_layer->text_color = color;
+}
+
+void text_layer_set_background_color(TextLayer *text_layer, GColor color) {
+  text_layer->background_color = color;
+}
+
+void text_layer_set_font(TextLayer *text_layer, GFont font) {
+  text_layer->font = font;
+}
+
+GFont fonts_get_system_font(const char *font_key) {
+  return (GFont)font_key;
+}
+
+// windows
+
+void window_init(Window *window, const char *debug_name) {
+  memset(window, 0, sizeof(*window));
+  layer_init(&window->layer, GRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT));
+  window->layer.window = window;
+  window->debug_name = debug_name;
+  window->background_color = GColorWhite;
+}
+
+static void apply_click_config(Window *window) {
+  memset(click_configs, 0, sizeof(click_configs));
+  if(window->click_config_provider == NULL) return;
+  ClickConfig *configs[NUM_BUTTONS];
+  void *context = window->click_config_context ? window->click_config_context : window;
+  for(int i=0; i<NUM_BUTTONS; i++) {
+    click_configs[i].context = context;
+    configs[i] = &click_configs[i];
+  }
+  window->click_config_provider(configs, context);
+}
+
+void window_stack_push(Window *window, bool animated) {
+  (void)animated;
+  top_window = window;
+  apply_click_config(window);
+  layer_mark_dirty(&window->layer);
+}
+
+void window_set_background_color(Window *window, GColor background_color) {
+  window->background_color = background_color;
+}
+
+void window_set_click_config_provider(Window *window, ClickConfigProvider click_config_provider) {
+  window->click_config_provider = click_config_provider;
+  if(window == top_window) apply_click_config(window);
+}
+
+static void render_layer(Layer *layer, GContext *ctx, GPoint origin, GRect clip) {
+  if(layer->hidden) return;
+  origin.x += layer->frame.origin.x;
+  origin.y += layer->frame.origin.y;
+  if(layer->clips) {
+    int x0 = maximum_int(clip.origin.x, origin.x);
+    int y0 = maximum_int(clip.origin.y, origin.y);
+    int x1 = minimum_int(clip.origin.x + clip.size.w, origin.x + layer->frame.size.w);
+    int y1 = minimum_int(clip.origin.y + clip.size.h, origin.y + layer->frame.size.h);
+    if(x1 <= x0 || y1 <= y0) return;
+    clip = GRect(x0, y0, x1 - x0, y1 - y0);
+  }
+  if(layer->update_proc) {
+    *ctx = (struct GContext){ GColorBlack, GColorBlack, GCompOpAssign, origin, clip };
+    uint64_t start = sim_wall_ns();
+    layer->update_proc(layer, ctx);
+    if(layer->update_proc != text_layer_update_proc) sim_stats.draw_ns += sim_wall_ns() - start;
+  }
+  for(Layer *child=layer->first_child; child; child=child->next_sibling) {
+    render_layer(child, ctx, origin, clip);
+  }
+}
+
+static void render_if_needed(void) {
+  if(dirty_rect.size.w <= 0 || dirty_rect.size.h <= 0 || top_window == NULL) return;
+  GRect clip = dirty_rect;
+  dirty_rect = GRect(0, 0, 0, 0);
+  uint64_t pixels_before = sim_stats.pixels_touched;
+
+  uint64_t start = sim_wall_ns();
+  GContext ctx = { GColorBlack, top_window->background_color, GCompOpAssign, GPoint(0, 0), clip };
+  graphics_fill_rect(&ctx, clip, 0, 0);
+  render_layer(&top_window->layer, &ctx, GPoint(0, 0), clip);
+  uint64_t elapsed = sim_wall_ns() - start;
+
+  sim_stats.frames++;
+  sim_stats.frame_ns = handler_ns_since_frame + elapsed;
+  handler_ns_since_frame = 0;
+  sim_stats.render_ns += elapsed;
+  if(elapsed > sim_stats.render_ns_max) sim_stats.render_ns_max = elapsed;
+  uint64_t pixels = sim_stats.pixels_touched - pixels_before;
+  if(pixels > sim_stats.pixels_touched_max) sim_stats.pixels_touched_max = pixels;
+  if(!app_frame_dirty) return;
+  app_frame_dirty = false;
+  sim_stats.app_frames++;
+  if(sim_config.on_frame) sim_config.on_frame(sim_stats.app_frames, now_ms);
+}
+
+// time
+
+static int simulated_seconds(void) {
+  int start = sim_config.start_hour * 3600 + sim_config.start_min * 60 + sim_config.start_sec;
+  int s = start + (sim_config.start_ms + now_ms) / 1000;
+  if(sim_config.replay) {
+    // a replay's minute changes on the logged ticks: on the watch's own
+    // clock the logged times run behind the wall clock
+    int minute = start - sim_config.start_sec + replayed_ticks * 60;
+    s = maximum_int(minute, minimum_int(s, minute + 59));
+  }
+  return s;
+}
+
+void get_time(PblTm *time) {
+  int s = simulated_seconds();
+  memset(time, 0, sizeof(*time));
+  time->tm_sec = s % 60;
+  time->tm_min = (s / 60) % 60;
+  time->tm_hour = (s / 3600) % 24;
+  time->tm_mday = 1 + s / 86400;
+  time->tm_mon = 4;
+  time->tm_year = 113;
+}
+
+bool clock_is_24h_style(void) {
+  return sim_config.clock_24h;
+}
+
+// timers and the event loop
+
+AppTimerHandle app_timer_send_event(AppContextRef app_ctx, uint32_t timeout_ms, uint32_t cookie) {
+  (void)app_ctx;
+  for(int i=0; i<MAX_TIMERS; i++) {
+    if(!timers[i].active) {
+      timers[i] = (SimTimer){ next_timer_handle++, now_ms + timeout_ms, cookie, true };
+      return timers[i].handle;
+    }
+  }
+  fprintf(stderr, "sim: more than %d timers pending\n", MAX_TIMERS);
+  exit(1);
+}
+
+bool app_timer_cancel_event(AppContextRef app_ctx, AppTimerHandle handle) {
+  (void)app_ctx;
+  for(int i=0; i<MAX_TIMERS; i++) {
+    if(timers[i].active && timers[i].handle == handle) {
+      timers[i].active = false;
+      return true;
+    }
+  }
+  return false;
+}
+
+static SimTimer *earliest_timer(void) {
+  SimTimer *earliest = NULL;
+  for(int i=0; i<MAX_TIMERS; i++) {
+    if(!timers[i].active) continue;
+    if(earliest == NULL || timers[i].deadline_ms < earliest->deadline_ms ||
+       (timers[i].deadline_ms == earliest->deadline_ms && timers[i].handle < earliest->handle)) {
+      earliest = &timers[i];
+    }
+  }
+  return earliest;
+}
+
+static uint32_t next_tick_ms(TimeUnits units) {
+  int unit_s = (units & SECOND_UNIT) ? 1 : 60;
+  int s = simulated_seconds();
+  uint32_t ms_into_second = (sim_config.start_ms + now_ms) % 1000;
+  return now_ms - ms_into_second + (uint32_t)(unit_s - s % unit_s) * 1000;
+}
+
+// handler time since `start` goes to the frame it leads to, which is
+// rendered now if anything was marked dirty
+static void account_handler(uint64_t start) {
+  uint64_t elapsed = sim_wall_ns() - start;
+  sim_stats.handler_ns += elapsed;
+  handler_ns_since_frame += elapsed;
+  render_if_needed();
+}
+
+static void dispatch_timer(AppContextRef app_task_ctx, PebbleAppHandlers *handlers, SimTimer *timer) {
+  timer->active = false;
+  sim_stats.timer_events++;
+  if(handlers->timer_handler) handlers->timer_handler(app_task_ctx, timer->handle, timer->cookie);
+}
+
+static void dispatch_tick(AppContextRef app_task_ctx, PebbleAppHandlers *handlers) {
+  PblTm tick_time;
+  get_time(&tick_time);
+  PebbleTickEvent event = { &tick_time, handlers->tick_info.tick_units };
+  sim_stats.tick_events++;
+  uint64_t tick_start = sim_wall_ns();
+  handlers->tick_info.tick_handler(app_task_ctx, &event);
+  uint64_t tick_elapsed = sim_wall_ns() - tick_start;
+  sim_stats.tick_ns += tick_elapsed;
+  if(tick_elapsed > sim_stats.tick_ns_max) sim_stats.tick_ns_max = tick_elapsed;
+}
+
+static void dispatch_click(ButtonId button) {
+  sim_stats.click_events++;
+  ClickConfig *config = &click_configs[button];
+  if(config->click.handler) config->click.handler(NULL, config->context);
+}
+
+// Runs a log instead of the timers, ticks and clicks above: before each
+// logged event exactly as many timers fire as did before it was recorded,
+// whenever they are due, and then the tick or click runs at the time it was
+// logged. The face's clock only moves on those wakeups, the logged times and
+// the logged moves of the RTC floor, which is how the watch's own clock
+// moves, so it reads just what it read then, on either clock. A logged
+// swarm or disperse wakeup is a checkpoint: the next timer has to fire at
+// that time.
+static void replay_log(AppContextRef app_task_ctx, PebbleAppHandlers *handlers, const EventLog *log) {
+  uint32_t logged_ms = 0;
+  bool checking = false;
+  uint32_t checkpoint_ms = 0;
+  for(int k=0; k<log->count; k++) {
+    const LoggedEvent *e = &log->events[k];
+    for(int n=0; n<e->wakeups; n++) {
+      SimTimer *timer = earliest_timer();
+      if(timer == NULL) {
+        sim_stats.replay_mismatches++;
+        break;
+      }
+      now_ms = maximum_int(now_ms, timer->deadline_ms);
+      uint64_t start = sim_wall_ns();
+      dispatch_timer(app_task_ctx, handlers, timer);
+      account_handler(start);
+      if(checking && clock_ms() != checkpoint_ms) sim_stats.replay_mismatches++;
+      checking = false;
+    }
+    logged_ms += e->dt_ms;
+    if(e->type == LOGGED_END) break;
+    if(e->type == LOGGED_TIMER) {
+      checking = true;
+      checkpoint_ms = logged_ms;
+      continue;
+    }
+    clock_advance_to(logged_ms);
+    now_ms = maximum_int(now_ms, logged_ms);
+    uint64_t start = sim_wall_ns();
+    if(e->type == LOGGED_TICK) {
+      replayed_ticks++;
+      if(handlers->tick_info.tick_handler) dispatch_tick(app_task_ctx, handlers);
+    } else if(e->type == LOGGED_CLICK && e->arg < NUM_BUTTONS) {
+      dispatch_click(e->arg);
+    }
+    account_handler(start);
+  }
+}
+
+static void run_loop(AppContextRef app_task_ctx, PebbleAppHandlers *handlers) {
+  int click = 0;
+  uint32_t tick_ms = next_tick_ms(handlers->tick_info.tick_units);
+  while(true) {
+    SimTimer *timer = earliest_timer();
+    uint32_t timer_ms = timer ? timer->deadline_ms : UINT32_MAX;
+    uint32_t click_ms = click < sim_config.num_clicks ? sim_config.click_times_ms[click] : UINT32_MAX;
+    uint32_t tick_due = handlers->tick_info.tick_handler ? tick_ms : UINT32_MAX;
+    uint32_t next = timer_ms;
+    if(tick_due < next) next = tick_due;
+    if(click_ms < next) next = click_ms;
+    if(next > sim_config.duration_ms) break;
+    now_ms = next;
+
+    uint64_t start = sim_wall_ns();
+    if(next == timer_ms) {
+      dispatch_timer(app_task_ctx, handlers, timer);
+    } else if(next == tick_due) {
+      dispatch_tick(app_task_ctx, handlers);
+      tick_ms = next_tick_ms(handlers->tick_info.tick_units);
+    } else {
+      click++;
+      dispatch_click(BUTTON_ID_BACK);
+    }
+    account_handler(start);
+  }
+}
+
+void app_event_loop(AppContextRef app_task_ctx, PebbleAppHandlers *handlers) {
+  // the watch face's timing follows the simulated clock, not the CPU's,
+  // unless the watch's own clock is under test; a replay's follows the log
+  if(sim_config.replay) {
+    clock_ms = timer_clock_ms;
+  } else if(!sim_config.watch_clock) {
+    clock_ms = sim_now_ms;
+  }
+  uint64_t start = sim_wall_ns();
+  if(handlers->init_handler) handlers->init_handler(app_task_ctx);
+  account_handler(start);
+
+  if(sim_config.replay) {
+    replay_log(app_task_ctx, handlers, sim_config.replay);
+  } else {
+    run_loop(app_task_ctx, handlers);
+  }
+
+  now_ms = maximum_int(now_ms, sim_config.duration_ms);
+  if(handlers->deinit_handler) handlers->deinit_handler(app_task_ctx);
+}
@@ -0,0 +1,237 @@
+// Runs the watch face on the host against a simulated clock, see host/sim.h.
+//
+//   fireflies-sim [-m minutes] [-t HH:MM[:SS]] [-24] [-c click_every_ms] [-r frame_ms] [-o frame.pbm] [-T trace.bin]
+//                [-R events.bin | -P events.bin] [-G dir | -g dir [-d pixels] [-n frames]]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+#include "render.h"
+#include "trace.h"
+#include "formation_metric.h"
+#include "golden.h"
+
+// the watch face's own state
+extern Rng rng;
+extern uint32_t rng_seed;
+extern int min_frame_ms;
+#ifdef FIREFLIES_PROFILE
+extern TextLayer text_header_layer;
+#endif
+
+static FormationMetric formation;
+
+static void measure_formation(uint32_t frame, uint32_t now_ms) {
+  formation_metric_frame(&formation, frame, now_ms);
+  golden_frame(frame);
+}
+
+static void write_pbm(const char *path) {
+  FILE *f = fopen(path, "w");
+  if(f == NULL) {
+    perror(path);
+    exit(1);
+  }
+  fprintf(f, "P1\n%d %d\n", SCREEN_WIDTH, SCREEN_HEIGHT);
+  for(int y=0; y<SCREEN_HEIGHT; y++) {
+    for(int x=0; x<SCREEN_WIDTH; x++) {
+      // PBM 1 is black
+      fputc(sim_get_pixel(x, y) ? '0' : '1', f);
+    }
+    fputc('\n', f);
+  }
+  fclose(f);
+}
+
+// the whole TraceBuffer, header included, exactly as it sits in the watch's RAM
+static void write_trace(const char *path) {
+#ifdef FIREFLIES_TRACE
+  FILE *f = fopen(path, "wb");
+  if(f == NULL) {
+    perror(path);
+    exit(1);
+  }
+  fwrite(&trace_buffer, sizeof(trace_buffer), 1, f);
+  fclose(f);
+#else
+  fprintf(stderr, "%s: not written, build with TRACE=1\n", path);
+#endif
+}
+
+#ifdef FIREFLIES_RECORD
+static void write_event_log(const char *path) {
+  FILE *f = fopen(path, "wb");
+  if(f == NULL) {
+    perror(path);
+    exit(1);
+  }
+  fwrite(&event_log, sizeof(event_log), 1, f);
+  fclose(f);
+}
+#endif
+
+// Loads a recorded run and sets up the clock, seed and duration to replay it.
+// The log only has whole seconds for the start time, so the fraction of a
+// second is recovered from the first minute tick, which lands on :00 (or,
+// on the watch's own clock, was logged up to a couple of seconds late).
+static EventLog replay_log;
+
+static void load_event_log(const char *path) {
+  FILE *f = fopen(path, "rb");
+  if(f == NULL) {
+    perror(path);
+    exit(1);
+  }
+  size_t n = fread(&replay_log, 1, sizeof(replay_log), f);
+  fclose(f);
+  if(n != sizeof(replay_log) || replay_log.magic != EVENT_LOG_MAGIC || replay_log.count > EVENT_LOG_CAPACITY) {
+    fprintf(stderr, "%s: not an event log\n", path);
+    exit(1);
+  }
+  if(replay_log.dropped) {
+    fprintf(stderr, "%s: %u events were dropped after the log filled up\n", path, replay_log.dropped);
+  }
+
+  rng_seed = replay_log.seed;
+  sim_config.start_hour = replay_log.start_hour;
+  sim_config.start_min = replay_log.start_min;
+  sim_config.start_sec = replay_log.start_sec;
+  sim_config.clock_24h = replay_log.clock_24h;
+  sim_config.start_ms = 0;
+  sim_config.duration_ms = 0;
+  bool ticked = false;
+  for(int k=0; k<replay_log.count; k++) {
+    sim_config.duration_ms += replay_log.events[k].dt_ms;
+    if(replay_log.events[k].type == LOGGED_TICK && !ticked) {
+      int ms = (60 - replay_log.start_sec) * 1000 - (int)sim_config.duration_ms;
+      sim_config.start_ms = ((ms % 1000) + 1000) % 1000;
+      ticked = true;
+    }
+  }
+  sim_config.num_clicks = 0;
+  sim_config.replay = &replay_log;
+}
+
+static void usage(const char *argv0) {
+  fprintf(stderr, "usage: %s [-m minutes] [-t HH:MM[:SS]] [-24] [-c click_every_ms] [-r frame_ms] [-w] [-o frame.pbm] [-T trace.bin]\n"
+                  "       [-R events.bin | -P events.bin] [-G dir | -g dir [-d pixels] [-n frames]]\n", argv0);
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  const char *pbm_path = NULL;
+  const char *trace_path = NULL;
+  const char *record_path = NULL;
+  const char *replay_path = NULL;
+  const char *golden_path = NULL;
+  bool golden_write = false;
+  int golden_budget = 0;
+  uint32_t golden_limit = 0;
+  uint32_t click_every_ms = 0;
+
+  for(int i=1; i<argc; i++) {
+    if(strcmp(argv[i], "-m") == 0 && i+1 < argc) {
+      sim_config.duration_ms = (uint32_t)(atof(argv[++i]) * 60000);
+    } else if(strcmp(argv[i], "-t") == 0 && i+1 < argc) {
+      if(sscanf(argv[++i], "%d:%d:%d", &sim_config.start_hour, &sim_config.start_min, &sim_config.start_sec) < 2) usage(argv[0]);
+    } else if(strcmp(argv[i], "-24") == 0) {
+      sim_config.clock_24h = true;
+    } else if(strcmp(argv[i], "-c") == 0 && i+1 < argc) {
+      click_every_ms = (uint32_t)atoi(argv[++i]);
+    } else if(strcmp(argv[i], "-r") == 0 && i+1 < argc) {
+      min_frame_ms = atoi(argv[++i]);
+      if(min_frame_ms <= 0) usage(argv[0]);
+    } else if(strcmp(argv[i], "-w") == 0) {
+      sim_config.watch_clock = true;
+    } else if(strcmp(argv[i], "-o") == 0 && i+1 < argc) {
+      pbm_path = argv[++i];
+    } else if(strcmp(argv[i], "-T") == 0 && i+1 < argc) {
+      trace_path = argv[++i];
+    } else if(strcmp(argv[i], "-R") == 0 && i+1 < argc) {
+      record_path = argv[++i];
+    } else if(strcmp(argv[i], "-P") == 0 && i+1 < argc) {
+      replay_path = argv[++i];
+    } else if((strcmp(argv[i], "-g") == 0 || strcmp(argv[i], "-G") == 0) && i+1 < argc) {
+      golden_write = argv[i][1] == 'G';
+      golden_path = argv[++i];
+    } else if(strcmp(argv[i], "-d") == 0 && i+1 < argc) {
+      golden_budget = atoi(argv[++i]);
+    } else if(strcmp(argv[i], "-n") == 0 && i+1 < argc) {
+      golden_limit = (uint32_t)atoi(argv[++i]);
+    } else {
+      usage(argv[0]);
+    }
+  }
+
+  if(click_every_ms > 0) {
+    for(uint32_t t=click_every_ms; t<=sim_config.duration_ms && sim_config.num_clicks < SIM_MAX_CLICKS; t+=click_every_ms) {
+      sim_config.click_times_ms[sim_config.num_clicks++] = t;
+    }
+  }
+
+  if(replay_path) load_event_log(replay_path);
+#ifndef FIREFLIES_RECORD
+  if(record_path) {
+    fprintf(stderr, "%s: can't record, build with RECORD=1\n", record_path);
+    exit(2);
+  }
+#endif
+
+  if(golden_path) golden_init(golden_path, golden_write, golden_budget, golden_limit);
+  sim_config.on_frame = measure_formation;
+  uint64_t start = sim_wall_ns();
+  pbl_main(NULL);
+  double wall_ms = (sim_wall_ns() - start) / 1e6;
+
+  double minutes = sim_config.duration_ms / 60000.0;
+  uint32_t frames = sim_stats.frames ? sim_stats.frames : 1;
+  printf("simulated   %.1f min in %.1f ms wall (%.0fx real time)\n",
+         minutes, wall_ms, sim_config.duration_ms / wall_ms);
+  printf("events      %u timer, %u tick, %u click\n",
+         sim_stats.timer_events, sim_stats.tick_events, sim_stats.click_events);
+  if(replay_path) {
+    printf("replay      %u events, seed %u, %u checkpoints missed\n",
+           replay_log.count, replay_log.seed, sim_stats.replay_mismatches);
+  }
+  printf("wakeups     %.1f per minute\n",
+         (sim_stats.timer_events + sim_stats.tick_events + sim_stats.click_events) / minutes);
+  printf("frames      %u (%.1f per second)\n",
+         sim_stats.frames, sim_stats.frames / (sim_config.duration_ms / 1000.0));
+  printf("render      %.2f us/frame avg, %.2f us max\n",
+         sim_stats.render_ns / 1e3 / frames, sim_stats.render_ns_max / 1e3);
+  printf("draw        %.2f us/frame in layer update procs\n", sim_stats.draw_ns / 1e3 / frames);
+  printf("handlers    %.2f us total/frame\n", sim_stats.handler_ns / 1e3 / frames);
+  printf("tick        %.2f us avg, %.2f us max\n",
+         sim_stats.tick_events ? sim_stats.tick_ns / 1e3 / sim_stats.tick_events : 0.0,
+         sim_stats.tick_ns_max / 1e3);
+  printf("draw calls  %.1f fill_circle, %.1f draw_bitmap per frame\n",
+         (double)sim_stats.fill_circle_calls / frames, (double)sim_stats.bitmap_draw_calls / frames);
+  printf("random      %.1f values/frame\n", (double)rng.generated / frames);
+  uint32_t stepped = render_stats.frames ? render_stats.frames : 1;
+  printf("culling     %.1f drawn, %.1f dark, %.1f off screen per step\n",
+         (double)render_stats.drawn / stepped, (double)render_stats.culled_dark / stepped,
+         (double)render_stats.culled_offscreen / stepped);
+  printf("pixels      %.0f touched/frame avg, %llu max\n",
+         (double)sim_stats.pixels_touched / frames, (unsigned long long)sim_stats.pixels_touched_max);
+
+  printf("legible     %.1f frames, %.0f ms to 95%% within 2 px (%u formations, %u never settled)\n",
+         formation.legible ? (double)formation.frames / formation.legible : 0.0,
+         formation.legible ? (double)formation.ms / formation.legible : 0.0,
+         formation.legible, formation.missed);
+  formation_metric_finish(&formation, sim_config.duration_ms);
+  printf("snapshot    %u frames saved (%.1f per minute), %u formations frozen\n",
+         formation.frames_saved, formation.frames_saved / minutes, formation.freezes);
+#ifdef FIREFLIES_PROFILE
+  const char *hud = text_layer_get_text(&text_header_layer);
+  if(hud) printf("hud\n%s", hud);
+#endif
+
+  int golden_failures = golden_finish();
+
+  if(pbm_path) write_pbm(pbm_path);
+  if(trace_path) write_trace(trace_path);
+#ifdef FIREFLIES_RECORD
+  if(record_path) write_event_log(record_path);
+#endif
+  return golden_failures || sim_stats.replay_mismatches ? 1 : 0;
+}
@@ -0,0 +1,63 @@
+#ifndef SIM_H
+#define SIM_H
+
+// Interface between the simulator driver (host/sim.c) and the SDK stand-in
+// (host/pebble_shim.c). The shim runs the watch face's event loop against a
+// simulated clock: timers, minute ticks and scripted button presses fire in
+// deadline order, and every dirty window is rendered into a 1bpp framebuffer
+// laid out like the watch's (20 byte rows, least significant bit leftmost).
+// In replay mode the ticks and button presses come from a recorded EventLog
+// instead, between as many timer wakeups as the log counted, see
+// src/event_log.h.
+
+#include "pebble_app.h"
+#include "event_log.h"
+
+#define SCREEN_WIDTH 144
+#define SCREEN_HEIGHT 168
+#define FRAMEBUFFER_ROW_BYTES 20
+#define SIM_MAX_CLICKS 1024
+
+typedef struct SimConfig {
+  uint32_t duration_ms;
+  int start_hour;
+  int start_min;
+  int start_sec;
+  int start_ms; // where in start_sec the run begins
+  bool clock_24h;
+  uint32_t click_times_ms[SIM_MAX_CLICKS]; // back button presses, ascending
+  int num_clicks;
+  void (*on_frame)(uint32_t frame, uint32_t now_ms); // after each of the app's frames
+  const EventLog *replay; // when set, ticks and clicks come from this instead
+  bool watch_clock; // leave the face on its own clock_ms(): timer wakeups with an RTC floor under them
+} SimConfig;
+
+typedef struct SimStats {
+  uint32_t frames;
+  uint32_t app_frames; // the ones not only redrawing text layers, counted by on_frame
+  uint32_t timer_events;
+  uint32_t tick_events;
+  uint32_t click_events;
+  uint32_t replay_mismatches; // logged swarm and disperse wakeups the next timer didn't fire at
+  uint32_t fill_circle_calls;
+  uint32_t bitmap_draw_calls;
+  uint64_t pixels_touched;
+  uint64_t pixels_touched_max;
+  uint64_t render_ns;
+  uint64_t render_ns_max;
+  uint64_t draw_ns; // in the app's own layer update procs
+  uint64_t handler_ns;
+  uint64_t frame_ns; // handlers since the previous frame plus rendering, for the frame just rendered
+  uint64_t tick_ns;
+  uint64_t tick_ns_max;
+} SimStats;
+
+extern SimConfig sim_config;
+extern SimStats sim_stats;
+extern uint8_t sim_framebuffer[FRAMEBUFFER_ROW_BYTES * SCREEN_HEIGHT];
+
+uint32_t sim_now_ms(void);
+uint64_t sim_wall_ns(void);
+bool sim_get_pixel(int x, int y);
+
+#endif
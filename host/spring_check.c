@@ -0,0 +1,138 @@
+// Checks advance_particles() against update_particles() stepped one step at
+// a time (see `make spring-check`). From the same swarm, or the same
+// formation, each runs N steps TRIALS times on different random numbers; for
+// every particle the mean and spread of where it ends up, and its mean size,
+// are compared. A check fails when the closed form's mean position is off by
+// more than MAX_BIAS_PX (plus the sampling error of the two means), its
+// spread is not within MAX_SPREAD_RATIO of the stepped one, or the mean size
+// is off by more than MAX_SIZE_ERROR. Both are timed too.
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "particle.h"
+
+#define TRIALS 400
+#define MAX_BIAS_PX 0.5
+#define MAX_SPREAD_RATIO 1.25
+#define MAX_SIZE_ERROR 0.25
+
+static Particles start, particles;
+static Rng rng;
+
+typedef struct Moments {
+  double x[NUM_PARTICLES], y[NUM_PARTICLES];
+  double xx[NUM_PARTICLES], yy[NUM_PARTICLES];
+  double size[NUM_PARTICLES];
+} Moments;
+
+static Moments stepped, closed;
+
+static void make_swarm(void) {
+  rng_init(&rng, 4);
+  for(int i=0; i<NUM_PARTICLES; i++) {
+    init_particle(&start, &rng, i, FPoint(rng_range(&rng, -10, 154), rng_range(&rng, -10, 178)),
+                  FPoint(72, 84), NORMAL_POWER);
+  }
+  for(int f=0; f<600; f++) {
+    rng_refill(&rng);
+    update_particles(&start, &rng, 0);
+  }
+}
+
+static void make_formation(void) {
+  make_swarm();
+  for(int i=0; i<NUM_PARTICLES; i++) {
+    set_particle_gravity(&start, &rng, i, FPoint(rng_range(&rng, 25, 120), rng_range(&rng, 60, 98)), TIGHT_POWER);
+    start.goal_size[i] = SCALAR(3.0F);
+  }
+  for(int f=0; f<100; f++) {
+    rng_refill(&rng);
+    update_particles(&start, &rng, 1);
+  }
+}
+
+static void accumulate(Moments *m) {
+  for(int i=0; i<NUM_PARTICLES; i++) {
+    double x = scalar_to_float(particles.x[i]), y = scalar_to_float(particles.y[i]);
+    m->x[i] += x;
+    m->y[i] += y;
+    m->xx[i] += x * x;
+    m->yy[i] += y * y;
+    m->size[i] += scalar_to_float(particles.size[i]);
+  }
+}
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// runs both integrators over TRIALS, returns true if they agree
+static bool check(const char *name, int showing_time, int steps) {
+  double stepped_ns = 0, closed_ns = 0;
+  stepped = (Moments){ { 0 } };
+  closed = (Moments){ { 0 } };
+  for(int t=0; t<TRIALS; t++) {
+    particles = start;
+    rng_init(&rng, 1000 + t);
+    double begin = now_ns();
+    for(int s=0; s<steps; s++) {
+      rng_refill(&rng);
+      update_particles(&particles, &rng, showing_time);
+    }
+    stepped_ns += now_ns() - begin;
+    accumulate(&stepped);
+
+    particles = start;
+    rng_init(&rng, 1000 + TRIALS + t);
+    begin = now_ns();
+    rng_refill(&rng);
+    advance_particles(&particles, &rng, showing_time, steps);
+    closed_ns += now_ns() - begin;
+    accumulate(&closed);
+  }
+
+  double bias = 0, sampling = 0, var_stepped = 0, var_closed = 0, size_error = 0;
+  for(int i=0; i<NUM_PARTICLES; i++) {
+    double sx = stepped.x[i] / TRIALS, sy = stepped.y[i] / TRIALS;
+    double cx = closed.x[i] / TRIALS, cy = closed.y[i] / TRIALS;
+    double vs = stepped.xx[i] / TRIALS - sx * sx + stepped.yy[i] / TRIALS - sy * sy;
+    double vc = closed.xx[i] / TRIALS - cx * cx + closed.yy[i] / TRIALS - cy * cy;
+    bias += sqrt((sx - cx) * (sx - cx) + (sy - cy) * (sy - cy));
+    sampling += sqrt((vs + vc) / TRIALS);
+    var_stepped += vs;
+    var_closed += vc;
+    size_error += fabs(stepped.size[i] - closed.size[i]) / TRIALS;
+  }
+  bias /= NUM_PARTICLES;
+  sampling /= NUM_PARTICLES;
+  size_error /= NUM_PARTICLES;
+  double spread_stepped = sqrt(var_stepped / NUM_PARTICLES);
+  double spread_closed = sqrt(var_closed / NUM_PARTICLES);
+  double ratio = spread_stepped > 0 ? spread_closed / spread_stepped : 1.0;
+
+  bool ok = bias <= MAX_BIAS_PX + 2 * sampling && ratio <= MAX_SPREAD_RATIO && ratio >= 1 / MAX_SPREAD_RATIO &&
+            size_error <= MAX_SIZE_ERROR;
+  printf("%-9s %2d steps: bias %.2f px (sampling %.2f), spread %.2f vs %.2f px, size off %.2f, "
+         "%.2f vs %.2f us  %s\n",
+         name, steps, bias, sampling, spread_closed, spread_stepped, size_error,
+         closed_ns / TRIALS / 1000, stepped_ns / TRIALS / 1000, ok ? "ok" : "FAIL");
+  return ok;
+}
+
+int main(void) {
+  static const int step_counts[] = { 3, 4, 8, 16, 32, 64 };
+  int failures = 0;
+  for(int k=0; k<(int)(sizeof(step_counts) / sizeof(step_counts[0])); k++) {
+    make_swarm();
+    if(!check("swarm", 0, step_counts[k])) failures++;
+  }
+  for(int k=0; k<(int)(sizeof(step_counts) / sizeof(step_counts[0])); k++) {
+    make_formation();
+    if(!check("formation", 1, step_counts[k])) failures++;
+  }
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,91 @@
+// Turns a TraceBuffer dumped from the watch (or by fireflies-sim -T) into a
+// timeline, oldest record first. Time on it is clock_ms(), sleep included;
+// "awake us" is the cycle count since the previous record, which stops while
+// the watch sleeps, so it only measures spans within one wakeup.
+//
+//   trace-decode trace.bin
+#include <stdio.h>
+#include <stdlib.h>
+#include "trace.h"
+
+static const char *event_names[NUM_TRACE_EVENTS] = {
+  [TRACE_FRAME_START] = "frame-start",
+  [TRACE_FRAME_END] = "frame-end",
+  [TRACE_TIMER] = "timer",
+  [TRACE_TICK] = "tick",
+  [TRACE_CLICK] = "click",
+  [TRACE_RETARGET_START] = "retarget-start",
+  [TRACE_RETARGET_END] = "retarget-end",
+};
+
+static const char *scheduled_event_names[] = { "frame", "swarm", "disperse" };
+
+static void print_args(const TraceRecord *r) {
+  switch(r->event) {
+    case TRACE_FRAME_START:
+      printf("steps=%u", r->arg0);
+      break;
+    case TRACE_FRAME_END:
+      printf("lit=%u next=%ums", r->arg0, r->arg1);
+      break;
+    case TRACE_TIMER:
+      printf("%s", r->arg0 < 3 ? scheduled_event_names[r->arg0] : "?");
+      break;
+    case TRACE_TICK:
+      printf("%02u:%02u", r->arg0, r->arg1);
+      break;
+    case TRACE_CLICK:
+      printf("button=%u", r->arg0);
+      break;
+    case TRACE_RETARGET_START:
+      printf("%02u:%02u", r->arg0 / 100, r->arg0 % 100);
+      break;
+    case TRACE_RETARGET_END:
+      printf("particles=%u", r->arg0);
+      break;
+    default:
+      printf("%u %u", r->arg0, r->arg1);
+  }
+}
+
+int main(int argc, char **argv) {
+  if(argc != 2) {
+    fprintf(stderr, "usage: %s trace.bin\n", argv[0]);
+    return 2;
+  }
+  FILE *f = fopen(argv[1], "rb");
+  if(f == NULL) {
+    perror(argv[1]);
+    return 1;
+  }
+  TraceBuffer buffer;
+  size_t n = fread(&buffer, 1, sizeof(buffer), f);
+  fclose(f);
+  if(n != sizeof(buffer) || buffer.magic != TRACE_MAGIC || buffer.capacity != TRACE_RECORDS) {
+    fprintf(stderr, "%s: not a %d record trace buffer\n", argv[1], TRACE_RECORDS);
+    return 1;
+  }
+
+  uint32_t count = buffer.written < TRACE_RECORDS ? buffer.written : TRACE_RECORDS;
+  uint32_t first = buffer.written - count;
+  printf("%u records (%u dropped), %u cycles/us\n", count, first, buffer.cycles_per_us);
+  printf("%10s %8s %10s  %-15s %s\n", "ms", "+ms", "awake us", "event", "args");
+
+  // both stamps wrap at 32 bits, so accumulate deltas rather than subtracting
+  // from the first record
+  uint64_t elapsed_ms = 0;
+  const TraceRecord *prev = &buffer.records[first & (TRACE_RECORDS - 1)];
+  for(uint32_t k=first; k<buffer.written; k++) {
+    const TraceRecord *r = &buffer.records[k & (TRACE_RECORDS - 1)];
+    uint32_t delta_ms = r->ms - prev->ms;
+    uint32_t delta_cycles = r->cycles - prev->cycles;
+    prev = r;
+    elapsed_ms += delta_ms;
+    printf("%10llu %8u %10.1f  %-15s ", (unsigned long long)elapsed_ms, delta_ms,
+           (double)delta_cycles / buffer.cycles_per_us,
+           r->event < NUM_TRACE_EVENTS && event_names[r->event] ? event_names[r->event] : "?");
+    print_args(r);
+    putchar('\n');
+  }
+  return 0;
+}
@@ -0,0 +1,56 @@
+#include "pebble_os.h"
+#include "clock.h"
+#include "event_log.h"
+
+// SDK 1 has no millisecond clock, and the DWT cycle counter stops whenever
+// the core sleeps, which is nearly all the time between events, so it is
+// left to the profiler. Wall time comes from two places instead: when the
+// scheduler's timer fires, at least the time it was armed for has passed
+// (clock_advance_to()), and the RTC, which get_time() reads to the second,
+// puts a floor under it between timers. The time spent awake since the last
+// of those (microseconds, usually) isn't counted. The event log records the
+// floor moving the clock, which a replay can't work out from its own RTC.
+static uint32_t now_ms;
+static uint32_t rtc_start;     // RTC second of the day at clock_start()
+static uint32_t rtc_last;
+static uint32_t rtc_days;      // midnights since clock_start()
+
+static uint32_t rtc_seconds(void) {
+  PblTm t;
+  get_time(&t);
+  uint32_t s = t.tm_hour * 3600 + t.tm_min * 60 + t.tm_sec;
+  // the minute tick wakes the face, so no more than one midnight goes by
+  if(s < rtc_last) rtc_days++;
+  rtc_last = s;
+  return s + rtc_days * 86400;
+}
+
+static uint32_t watch_clock_ms(void) {
+  // clock_start() may have been anywhere in its second, so only whole
+  // seconds after the one it saw are certain to have passed
+  uint32_t rtc_elapsed = rtc_seconds() - rtc_start;
+  uint32_t floor_ms = (rtc_elapsed - 1) * 1000;
+  if(rtc_elapsed > 1 && (int32_t)(floor_ms - now_ms) > 0) {
+    now_ms = floor_ms;
+    EVENT_LOG(LOGGED_RTC, 0);
+  }
+  return now_ms;
+}
+
+uint32_t timer_clock_ms(void) {
+  return now_ms;
+}
+
+uint32_t (*clock_ms)(void) = watch_clock_ms;
+
+void clock_start(void) {
+  rtc_last = 0;
+  rtc_days = 0;
+  rtc_start = rtc_seconds();
+  now_ms = 0;
+}
+
+// never backwards
+void clock_advance_to(uint32_t ms) {
+  if((int32_t)(ms - now_ms) > 0) now_ms = ms;
+}
@@ -0,0 +1,20 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+
+// Milliseconds since clock_start(), for the scheduler, fixed-step physics
+// and the event log. SDK 1 has no millisecond clock, so on the watch this is
+// the times timer wakeups were armed for, with the RTC as a floor so that
+// time spent asleep still counts (see clock.c); the simulator swaps in its
+// own clock.
+extern uint32_t (*clock_ms)(void);
+// the watch clock without the RTC floor, for replaying a log that has the
+// floor's moves in it
+uint32_t timer_clock_ms(void);
+
+void clock_start(void);
+// a timer armed for wall time `ms` has fired, so it is at least that late
+void clock_advance_to(uint32_t ms);
+
+#endif
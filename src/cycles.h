@@ -0,0 +1,40 @@
+#ifndef CYCLES_H
+#define CYCLES_H
+
+#include <stdint.h>
+
+// A free-running 32-bit timestamp for the debug builds' profiler and trace.
+// On the watch it is the Cortex-M3 DWT cycle counter (the STM32F2 runs at
+// 64 MHz, so it wraps every 67 s); on the host it is monotonic nanoseconds.
+
+#ifdef __arm__
+#define CYCLES_PER_US 64
+#define DEMCR (*(volatile uint32_t *)0xE000EDFC)
+#define DWT_CTRL (*(volatile uint32_t *)0xE0001000)
+#define DWT_CYCCNT (*(volatile uint32_t *)0xE0001004)
+
+static inline uint32_t cycles_now(void) {
+  return DWT_CYCCNT;
+}
+
+static inline void cycles_start(void) {
+  if(DWT_CTRL & 1) return;
+  DEMCR |= 1 << 24;  // TRCENA
+  DWT_CYCCNT = 0;
+  DWT_CTRL |= 1;     // CYCCNTENA
+}
+#else
+#include <time.h>
+#define CYCLES_PER_US 1000
+
+static inline uint32_t cycles_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+static inline void cycles_start(void) {
+}
+#endif
+
+#endif
@@ -0,0 +1,43 @@
+#ifdef FIREFLIES_RECORD
+
+#include "pebble_os.h"
+#include "clock.h"
+#include "event_log.h"
+
+EventLog event_log;
+static uint32_t last_event_ms;
+static uint16_t wakeups; // since the previous event
+
+void event_log_start(uint32_t seed) {
+  PblTm now;
+  last_event_ms = clock_ms();
+  wakeups = 0;
+  get_time(&now);
+  event_log = (EventLog){
+    .magic = EVENT_LOG_MAGIC,
+    .seed = seed,
+    .start_hour = now.tm_hour,
+    .start_min = now.tm_min,
+    .start_sec = now.tm_sec,
+    .clock_24h = clock_is_24h_style(),
+  };
+}
+
+void event_log_add(LoggedEventType type, uint8_t arg) {
+  // first: reading the watch clock can log the RTC floor moving it, which
+  // came before this event
+  uint32_t now = clock_ms();
+  if(event_log.count == EVENT_LOG_CAPACITY) {
+    event_log.dropped++;
+    return;
+  }
+  event_log.events[event_log.count++] = (LoggedEvent){ now - last_event_ms, type, arg, wakeups };
+  last_event_ms = now;
+  wakeups = 0;
+}
+
+void event_log_wakeup(void) {
+  wakeups++;
+}
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <stdint.h>
+
+// Record of the input that reaches the watch face, built only with
+// -DFIREFLIES_RECORD (make RECORD=1). Minute ticks and back button presses
+// are stored with the clock_ms() the face read for them, as milliseconds
+// since the previous event, next to the RNG seed and the wall clock time at
+// start, which is all the input the face has. The scheduler's own wakeups
+// follow from those, so frames aren't logged, but every event says how many
+// timer wakeups came before it: on the watch's own clock an input lands
+// between two wakeups without its time saying which, so the count is what
+// orders them. The RTC floor under that clock moving it forward is logged
+// too, and swarm and disperse wakeups are, as checkpoints. fireflies-sim -P
+// replays a log through the same handlers, firing the timers itself, on a
+// clock that only moves on those wakeups and logged times, and reproduces
+// the run frame for frame, on either clock.
+
+typedef enum {
+  LOGGED_TIMER = 1, // arg: the ScheduledEvent it ran, never EVENT_FRAME
+  LOGGED_TICK,
+  LOGGED_CLICK,     // arg: button
+  LOGGED_END,       // handle_deinit(), so a replay runs as long
+  LOGGED_RTC,       // the RTC floor moved clock_ms() up to this event's time
+} LoggedEventType;
+
+typedef struct {
+  uint16_t dt_ms; // since the previous event, or since handle_init
+  uint8_t type;
+  uint8_t arg;
+  uint16_t wakeups; // timer wakeups that finished since the previous event
+} LoggedEvent;
+
+// 6 KB; a swarm or disperse wakeup every 5 to 15 s and a tick a minute fill
+// it in about two hours. The swarm wakeups also keep dt_ms under 16 bits,
+// and wakeups: no more than one frame every 50 ms between them.
+#define EVENT_LOG_CAPACITY 1024
+#define EVENT_LOG_MAGIC 0x33454646 // "FFE3"
+
+typedef struct {
+  uint32_t magic;
+  uint32_t seed;
+  uint8_t start_hour;
+  uint8_t start_min;
+  uint8_t start_sec;
+  uint8_t clock_24h;
+  uint16_t count;
+  uint16_t dropped; // events after the log filled up
+  LoggedEvent events[EVENT_LOG_CAPACITY];
+} EventLog;
+
+#ifdef FIREFLIES_RECORD
+
+extern EventLog event_log;
+
+void event_log_start(uint32_t seed);
+void event_log_add(LoggedEventType type, uint8_t arg);
+void event_log_wakeup(void);
+
+#define EVENT_LOG_START(seed) event_log_start(seed)
+#define EVENT_LOG(type, arg) event_log_add((type), (arg))
+#define EVENT_LOG_WAKEUP() event_log_wakeup()
+
+#else
+
+#define EVENT_LOG_START(seed) ((void)0)
+#define EVENT_LOG(type, arg) ((void)0)
+#define EVENT_LOG_WAKEUP() ((void)0)
+
+#endif
+
+#endif
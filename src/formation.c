@@ -0,0 +1,94 @@
+#include <stdlib.h>
+#include "formation.h"
+
+// how far apart in x order two pairs can be and still be tried for a swap
+#define SWAP_WINDOW 8
+#define SWAP_PASSES 2
+// how close (in whole pixels each way) a particle must be to count as settled
+#define SETTLED_DISTANCE 2
+
+static int distance_sq(const Particles *ps, int i, GPoint target) {
+  int dx = scalar_to_int(ps->x[i]) - target.x;
+  int dy = scalar_to_int(ps->y[i]) - target.y;
+  return dx*dx + dy*dy;
+}
+
+static void sort_by_key(uint8_t *order, const int *key, int count) {
+  for(int i=1; i<count; i++) {
+    uint8_t item = order[i];
+    int j = i;
+    while(j > 0 && key[order[j-1]] > key[item]) {
+      order[j] = order[j-1];
+      j--;
+    }
+    order[j] = item;
+  }
+}
+
+// Approximate minimum total travel matching of particles to targets, cheap
+// enough to run on every minute tick: both sides are sorted by x and paired
+// in order (optimal if everything were on one line), then pairs close in that
+// order swap targets whenever that shortens their combined squared distance.
+void assign_targets(Particles *ps, Rng *rng, const uint8_t *members, const Target *targets, int count,
+                    uint8_t *assignment) {
+  uint8_t particle_order[NUM_PARTICLES];
+  uint8_t target_order[NUM_PARTICLES];
+  int key[NUM_PARTICLES] = {0};
+
+  for(int k=0; k<count; k++) {
+    particle_order[k] = k;
+    key[k] = scalar_to_int(ps->x[members[k]]);
+  }
+  sort_by_key(particle_order, key, count);
+
+  for(int k=0; k<count; k++) {
+    target_order[k] = k;
+    key[k] = targets[k].point.x;
+  }
+  sort_by_key(target_order, key, count);
+
+  for(int pass=0; pass<SWAP_PASSES; pass++) {
+    for(int a=0; a<count; a++) {
+      int pa = members[particle_order[a]];
+      for(int b=a+1; b<count && b<=a+SWAP_WINDOW; b++) {
+        int pb = members[particle_order[b]];
+        GPoint ta = targets[target_order[a]].point;
+        GPoint tb = targets[target_order[b]].point;
+        if(distance_sq(ps, pa, tb) + distance_sq(ps, pb, ta) <
+           distance_sq(ps, pa, ta) + distance_sq(ps, pb, tb)) {
+          uint8_t t = target_order[a];
+          target_order[a] = target_order[b];
+          target_order[b] = t;
+        }
+      }
+    }
+  }
+
+  for(int k=0; k<count; k++) {
+    int i = members[particle_order[k]];
+    const Target *target = &targets[target_order[k]];
+    set_particle_gravity(ps, rng, i, FPoint(target->point.x, target->point.y), TIGHT_POWER);
+    ps->goal_size[i] = target->size;
+    assignment[particle_order[k]] = target_order[k];
+  }
+}
+
+// The particles in formation are the ones at TIGHT_POWER. Everyone else has
+// to be dark with a goal size of 0, since while the time is showing nothing
+// starts a blink and a dark particle stays dark.
+bool formation_settled(const Particles *ps) {
+  int members = 0;
+  for(int i=0; i<NUM_PARTICLES; i++) {
+    if(ps->power[i] != TIGHT_POWER) {
+      if(scalar_to_int(ps->size[i]) > 0 || ps->goal_size[i] > SCALAR(0)) return false;
+      continue;
+    }
+    int dx = scalar_to_int(ps->x[i] - ps->grav_x[i]);
+    int dy = scalar_to_int(ps->y[i] - ps->grav_y[i]);
+    if(abs(dx) > SETTLED_DISTANCE || abs(dy) > SETTLED_DISTANCE) return false;
+    // update_particles() stops resizing once within a pixel of the goal
+    if(abs(scalar_to_int(ps->size[i] - ps->goal_size[i])) > 0) return false;
+    members++;
+  }
+  return members > 0;
+}
@@ -0,0 +1,21 @@
+#ifndef FORMATION_H
+#define FORMATION_H
+
+#include "pebble_os.h"
+#include "particle.h"
+
+typedef struct Target
+{
+  GPoint point;
+  scalar_t size;
+} Target;
+
+// sends members[k] to targets[assignment[k]]
+void assign_targets(Particles *ps, Rng *rng, const uint8_t *members, const Target *targets, int count,
+                    uint8_t *assignment);
+
+// every particle in formation is at its target and done resizing, and the
+// rest are dark: nothing on screen would change but jitter
+bool formation_settled(const Particles *ps);
+
+#endif
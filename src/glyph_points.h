@@ -0,0 +1,105 @@
+// Generated by bin/compile-glyphs.py from doc/glyphs, do not edit.
+// The first 45 lit pixels of each digit in farthest-point order.
+
+static const GlyphPixel glyph_0_points[] = {
+  {21,19}, { 3, 5}, { 4,33}, {18, 3}, {19,34}, { 1,19}, {10, 1}, {22,10},
+  {22,27}, {11,36}, { 2,12}, { 2,26}, {23,15}, { 6, 2}, {14, 2}, {19, 7},
+  {23,23}, {15,35}, {19,30}, { 4, 9}, { 3,16}, { 3,22}, { 4,29}, { 8,34},
+  { 6, 5}, {21,13}, { 8, 3}, {20, 5}, { 2, 8}, {21, 8}, {20,11}, { 1,14},
+  {21,16}, {23,18}, {22,21}, { 1,23}, {21,24}, {20,26}, {21,29}, { 3,31},
+  {18,32}, { 6,35}, { 8, 1}, {12, 1}, {16, 2},
+};
+
+static const GlyphPixel glyph_1_points[] = {
+  {10,15}, {12,35}, {11, 0}, { 1, 7}, {11,25}, {12, 8}, { 6, 3}, {12,20},
+  {10,30}, {10, 4}, {10,11}, { 4, 6}, {12,13}, {12,17}, {10,22}, {12,28},
+  {12,32}, { 9, 1}, {12, 2}, {12, 5}, {10, 7}, {10,18}, {12,23}, {10,27},
+  {10,33}, { 8, 3}, { 6, 5}, {10, 9}, {12,10}, {10,13}, {12,15}, {10,20},
+  {12,30}, {10,35}, {10, 2}, {11, 3}, { 5, 4}, { 7, 4}, { 2, 6}, {11, 6},
+  { 3, 7}, { 2, 8}, {11,12}, {11,14}, {11,16},
+};
+
+static const GlyphPixel glyph_2_points[] = {
+  {13,21}, { 7, 1}, { 1,36}, {22,36}, {20, 8}, {11,35}, { 7,28}, {15, 1},
+  {19,16}, { 2, 5}, {17,35}, { 4,32}, {11,25}, { 6,36}, {18, 4}, {11, 2},
+  {19,12}, {16,18}, { 5, 4}, {14,36}, {17, 2}, { 3, 3}, {14, 3}, {19, 6},
+  {18,14}, {15,20}, {12,23}, { 9,26}, { 5,30}, { 2,33}, { 3,35}, { 8,35},
+  {20,35}, { 9, 1}, {13, 1}, { 5, 2}, { 7, 3}, {16, 4}, {19,10}, {20,14},
+  {17,16}, {18,18}, {15,22}, { 9,28}, { 7,30},
+};
+
+static const GlyphPixel glyph_3_points[] = {
+  {14,19}, { 1,35}, { 2, 3}, {19, 3}, {17,35}, {22,26}, {20,12}, {10, 1},
+  { 6,17}, { 9,36}, {19,21}, {21,31}, {15, 1}, {21, 7}, {16,15}, { 6, 2},
+  {10,18}, { 5,35}, {13,35}, {18,32}, {19,15}, {19, 9}, {17,19}, {21,23},
+  {20,28}, {12, 2}, {17, 2}, { 4, 4}, { 1, 5}, {18, 5}, {21,10}, {18,13},
+  {14,16}, {12,17}, { 7,19}, {20,25}, {22,29}, { 0,33}, {20,33}, { 3,34},
+  {15,34}, { 8, 1}, { 4, 2}, {15, 3}, {20, 5},
+};
+
+static const GlyphPixel glyph_4_points[] = {
+  {18,18}, { 0,26}, {20, 0}, {20,35}, { 6,16}, {26,26}, {13, 8}, {11,26},
+  {20,10}, {18,28}, { 3,21}, {15, 3}, {20,23}, {20, 5}, { 9,12}, { 6,25},
+  {19,14}, {15,25}, {22,26}, {20,31}, {17, 0}, { 6,19}, { 3,25}, {15, 6},
+  {18, 8}, {11,10}, {20,20}, { 1,23}, {18,25}, {18,33}, {18, 2}, {18,11},
+  { 8,14}, {20,16}, {18,21}, { 9,25}, {24,25}, {20,27}, {20, 2}, {13, 6},
+  {20, 7}, {11,12}, {20,12}, { 8,16}, {18,16},
+};
+
+static const GlyphPixel glyph_5_points[] = {
+  {11,16}, { 3,35}, { 3, 0}, {20,31}, {19, 2}, {21,20}, { 2,11}, {12,35},
+  {11, 1}, { 5,16}, {17,16}, { 4, 6}, {20,25}, {16,33}, {15, 0}, { 7, 2},
+  { 7,34}, { 1,32}, { 2,15}, { 8,15}, {14,15}, {18,19}, {19,28}, { 3, 3},
+  { 2, 8}, {19,22}, { 6, 0}, { 9, 0}, {18, 0}, {13, 2}, {16, 2}, { 4, 9},
+  { 3,13}, {15,17}, {21,23}, {21,27}, {18,30}, {10,34}, {14,34}, {13, 0},
+  { 5, 2}, { 9, 2}, { 2, 6}, {21,29}, {18,32},
+};
+
+static const GlyphPixel glyph_6_points[] = {
+  { 8,17}, {16,36}, {19, 1}, { 2,31}, {22,23}, { 6, 4}, { 0,22}, { 1,12},
+  {17,16}, { 8,36}, {20,30}, {12, 1}, { 2,17}, { 3, 8}, {12,15}, { 2,26},
+  {20,19}, {12,35}, { 4,20}, {20,26}, { 5,33}, {18,33}, { 9, 2}, {15, 2},
+  { 5,17}, { 0,19}, {22,28}, { 4, 6}, { 2,10}, { 2,14}, { 9,15}, {15,15},
+  {19,17}, { 2,21}, {21,21}, { 1,24}, { 1,28}, { 3,29}, { 7,34}, {17, 1},
+  { 8, 4}, { 6, 6}, { 3,12}, { 0,17}, {15,17},
+};
+
+static const GlyphPixel glyph_7_points[] = {
+  {16,13}, { 6,35}, { 1, 0}, {23, 0}, {13,25}, {12, 2}, {19, 6}, {14,19},
+  { 9,30}, { 7, 0}, {17, 0}, {19,10}, { 4, 2}, {20, 2}, {15,16}, {12,22},
+  {10,26}, { 9,34}, {10, 0}, {14, 0}, {22, 4}, { 8, 2}, {15, 2}, {18, 8},
+  {17,11}, {17,15}, {16,18}, {11,24}, {12,27}, {11,29}, { 8,32}, { 3, 0},
+  { 5, 0}, {12, 0}, {19, 0}, {21, 0}, { 1, 2}, { 6, 2}, {10, 2}, {17, 2},
+  {22, 2}, {20, 4}, {21, 6}, {20, 8}, {18,13},
+};
+
+static const GlyphPixel glyph_8_points[] = {
+  {11,18}, {17,36}, {16, 1}, { 2,31}, { 2, 7}, {22,24}, {21,12}, { 3,22},
+  { 9,35}, { 8, 1}, { 4,14}, {22,31}, {17,20}, {20, 6}, {16,15}, { 4, 3},
+  { 7,20}, { 1,26}, {12, 2}, { 8,15}, { 5,34}, {13,35}, { 4,10}, {19,33},
+  {19, 3}, {14,19}, {20,21}, {21,27}, {20, 9}, {18,13}, { 6, 2}, { 3, 5},
+  { 2,11}, {19,11}, { 5,12}, { 6,16}, {10,16}, {14,16}, { 8,18}, { 5,21},
+  {18,22}, { 2,24}, { 3,27}, { 1,29}, { 4,32},
+};
+
+static const GlyphPixel glyph_9_points[] = {
+  {15,20}, { 7, 1}, { 3,36}, { 1,15}, {21, 7}, {17,33}, { 7,22}, {22,15},
+  {22,24}, {15, 1}, { 2, 7}, {10,35}, {19,28}, { 3,19}, {18, 4}, {19,18},
+  {11, 2}, {20,11}, {11,21}, { 1,11}, { 4, 3}, {22,20}, {14,35}, { 6,35},
+  {20,22}, {19,31}, {17, 2}, { 6, 4}, { 3, 5}, {20, 5}, { 3, 9}, {22,10},
+  { 2,13}, {21,13}, { 3,16}, {20,16}, {17,19}, { 5,20}, {13,22}, {20,25},
+  {21,27}, { 8,36}, {12,36}, { 9, 1}, {13, 1},
+};
+
+const Glyph glyphs[10] = {
+  { glyph_0_points, sizeof(glyph_0_points) / sizeof(GlyphPixel) },
+  { glyph_1_points, sizeof(glyph_1_points) / sizeof(GlyphPixel) },
+  { glyph_2_points, sizeof(glyph_2_points) / sizeof(GlyphPixel) },
+  { glyph_3_points, sizeof(glyph_3_points) / sizeof(GlyphPixel) },
+  { glyph_4_points, sizeof(glyph_4_points) / sizeof(GlyphPixel) },
+  { glyph_5_points, sizeof(glyph_5_points) / sizeof(GlyphPixel) },
+  { glyph_6_points, sizeof(glyph_6_points) / sizeof(GlyphPixel) },
+  { glyph_7_points, sizeof(glyph_7_points) / sizeof(GlyphPixel) },
+  { glyph_8_points, sizeof(glyph_8_points) / sizeof(GlyphPixel) },
+  { glyph_9_points, sizeof(glyph_9_points) / sizeof(GlyphPixel) },
+};
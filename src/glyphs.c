@@ -0,0 +1,2 @@
+#include "glyphs.h"
+#include "glyph_points.h"
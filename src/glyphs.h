@@ -0,0 +1,23 @@
+#ifndef GLYPHS_H
+#define GLYPHS_H
+
+#include <stdint.h>
+
+typedef struct GlyphPixel
+{
+  uint8_t x;
+  uint8_t y;
+} GlyphPixel;
+
+// Lit pixels of a digit, ordered so that any prefix covers the whole digit
+// evenly, as many as the most particles one digit is given (see
+// bin/compile-glyphs.py).
+typedef struct Glyph
+{
+  const GlyphPixel *pixels;
+  uint16_t count;
+} Glyph;
+
+extern const Glyph glyphs[10];
+
+#endif
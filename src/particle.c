@@ -0,0 +1,373 @@
+#include "particle.h"
+
+#ifdef FIREFLIES_FIXED_POINT
+scalar_t random_scalar(Rng *rng, scalar_t min, scalar_t max) {
+  return min + (scalar_t)(((uint64_t)rng_next(rng) * (uint32_t)(max - min)) >> 32);
+}
+
+// the size step divides by an integer so it stays a single hardware divide
+#define random_divisor(rng, min, max) rng_range((rng), (min), (max))
+#else
+scalar_t random_scalar(Rng *rng, scalar_t min, scalar_t max) {
+  return min + (float)(rng_next(rng) >> 8) * (1.0F / 16777216.0F) * (max - min);
+}
+
+#define random_divisor(rng, min, max) random_scalar((rng), (min), (max))
+#endif
+
+// -log2(u / 2^32) in Q16.16, for u > 0: the whole bits from the leading
+// zeros, then the fraction a bit at a time by squaring the mantissa
+static uint32_t neg_log2(uint32_t u) {
+  int zeros = __builtin_clz(u);
+  uint64_t x = (uint64_t)u << zeros; // in [1, 2) as Q31
+  uint32_t fraction = 0;
+  for(int b=15; b>=0; b--) {
+    x = (x * x) >> 31;
+    if(x >= (1ULL << 32)) {
+      x >>= 1;
+      fraction |= 1u << b;
+    }
+  }
+  return ((uint32_t)(zeros + 1) << 16) - fraction;
+}
+
+// 1 / -log2(1 - BLINK_CHANCE), with -ln(1 - p) from its series since
+// there's no libm; folded at compile time
+#define BLINK_STEPS_PER_BIT (0.69314718 / (BLINK_CHANCE + BLINK_CHANCE * BLINK_CHANCE / 2.0 + \
+                                           BLINK_CHANCE * BLINK_CHANCE * BLINK_CHANCE / 3.0))
+
+// Steps until a firefly's next blink onset. Every step used to be a
+// BLINK_CHANCE trial of its own; the wait for the first success is
+// geometric, so it is drawn in one go by inverting its distribution.
+static uint32_t steps_to_blink(Rng *rng) {
+  uint64_t bits = neg_log2(rng_next(rng) | 1);
+  return (uint32_t)((bits * (uint64_t)(BLINK_STEPS_PER_BIT * 65536.0)) >> 32) + 1;
+}
+
+static void schedule_blink(Particles *ps, Rng *rng, int i) {
+  uint32_t at = ps->step + steps_to_blink(rng);
+  int slot = at % BLINK_WHEEL_SLOTS;
+  ps->blink_at[i] = at;
+  ps->blink_next[i] = ps->blink_wheel[slot];
+  ps->blink_wheel[slot] = i + 1;
+}
+
+static void unschedule_blink(Particles *ps, int i) {
+  uint8_t *link = &ps->blink_wheel[ps->blink_at[i] % BLINK_WHEEL_SLOTS];
+  while(*link != i + 1) link = &ps->blink_next[*link - 1];
+  *link = ps->blink_next[i];
+  ps->blink_at[i] = 0;
+}
+
+// Sizes only move while they are a whole pixel or more from their goal;
+// compared directly, so it is the same exact cutoff in both engines.
+static inline int within_a_pixel(scalar_t a, scalar_t b) {
+  return a - b < SCALAR(1) && b - a < SCALAR(1);
+}
+
+uint32_t steps_until_lit(const Particles *ps) {
+  uint32_t next = UINT32_MAX;
+  for(int i=0; i<NUM_PARTICLES; i++) {
+    if(!within_a_pixel(ps->size[i], SCALAR(MIN_SIZE)) || ps->goal_size[i] != SCALAR(MIN_SIZE)) return 0;
+    if(ps->blink_at[i] != 0 && ps->blink_at[i] - ps->step < next) next = ps->blink_at[i] - ps->step;
+  }
+  return next;
+}
+
+void init_particle(Particles *ps, Rng *rng, int i, FPoint position, FPoint grav_center, int power) {
+  ps->x[i] = position.x;
+  ps->y[i] = position.y;
+  ps->dx[i] = ps->dy[i] = SCALAR(0);
+  ps->behind[i] = 0;
+  set_particle_gravity(ps, rng, i, grav_center, power);
+  ps->size[i] = ps->goal_size[i] = ps->ds[i] = SCALAR(MIN_SIZE);
+  if(ps->blink_at[i] != 0) unschedule_blink(ps, i);
+  schedule_blink(ps, rng, i);
+}
+
+// A firefly that has blinked up to full size heads back down, except in
+// formation, where the digits hold whatever size they were given. A blink
+// that was under way when the time came up still ends, or the firefly would
+// stay lit outside the digits (and keep the formation from settling) until
+// they disperse.
+static int blink_ends(const Particles *ps, int i, int showing_time) {
+  if(showing_time && ps->power[i] == TIGHT_POWER) return 0;
+  return within_a_pixel(ps->size[i], SCALAR(MAX_SIZE));
+}
+
+// Takes a step on the blink wheel, touching only the fireflies whose onset
+// falls on it: a dark one lights up, unless the time is up, and every one
+// draws its next onset. An onset that finds its firefly lit (or the time up)
+// is lost, just as that step's trial would have been.
+static void turn_blink_wheel(Particles *ps, Rng *rng, int showing_time) {
+  uint32_t step = ++ps->step;
+  int slot = step % BLINK_WHEEL_SLOTS;
+  int k = ps->blink_wheel[slot];
+  ps->blink_wheel[slot] = 0;
+  while(k != 0) {
+    int i = k - 1;
+    k = ps->blink_next[i];
+    if(ps->blink_at[i] != step) {
+      // due on a later lap
+      ps->blink_next[i] = ps->blink_wheel[slot];
+      ps->blink_wheel[slot] = i + 1;
+      continue;
+    }
+    if(showing_time == 0 && within_a_pixel(ps->size[i], SCALAR(MIN_SIZE))) {
+      ps->goal_size[i] = SCALAR(MAX_SIZE);
+    }
+    schedule_blink(ps, rng, i);
+  }
+}
+
+// Jitter and the size step are the only parts that draw random numbers, so
+// they run first in one pass (drawing in the same order as a per-particle
+// loop would); the motion pass after it is straight-line arithmetic. Blink
+// onsets come off the blink wheel before either.
+static inline void jitter_and_resize(Particles *ps, Rng *rng, int i, int showing_time) {
+  if(rng_chance(rng, 0.4F)) {
+    ps->dx[i] += random_scalar(rng, SCALAR(-JITTER), SCALAR(JITTER));
+    ps->dy[i] += random_scalar(rng, SCALAR(-JITTER), SCALAR(JITTER));
+  }
+
+  // update size
+  scalar_t size = ps->size[i];
+  if(blink_ends(ps, i, showing_time)) {
+    ps->goal_size[i] = SCALAR(MIN_SIZE);
+  }
+
+  // a size that has come within a pixel of its goal stops there, and builds
+  // no speed while it sits (a dark firefly would carry it into its next goal)
+  if(within_a_pixel(size, ps->goal_size[i])) {
+    ps->ds[i] = SCALAR(0);
+  } else {
+    ps->ds[i] += -(size - ps->goal_size[i])/random_divisor(rng, 1000, 5000);
+    size += ps->ds[i];
+  }
+  if(size > SCALAR(MAX_SIZE)) size = SCALAR(MAX_SIZE);
+  if(size < SCALAR(MIN_SIZE)) size = SCALAR(MIN_SIZE);
+  ps->size[i] = size;
+}
+
+static inline void move_particle(Particles *ps, int i) {
+  // gravitate towards goal
+  scalar_t dx = ps->dx[i] - (ps->x[i] - ps->grav_x[i])/ps->power[i];
+  scalar_t dy = ps->dy[i] - (ps->y[i] - ps->grav_y[i])/ps->power[i];
+
+  // damping
+  dx = scalar_mul(dx, SCALAR(DAMPING));
+  dy = scalar_mul(dy, SCALAR(DAMPING));
+
+  // snap to max
+  if(dx >  SCALAR(MAX_SPEED)) dx =  SCALAR(MAX_SPEED);
+  if(dx < -SCALAR(MAX_SPEED)) dx = -SCALAR(MAX_SPEED);
+  if(dy >  SCALAR(MAX_SPEED)) dy =  SCALAR(MAX_SPEED);
+  if(dy < -SCALAR(MAX_SPEED)) dy = -SCALAR(MAX_SPEED);
+
+  ps->dx[i] = dx;
+  ps->dy[i] = dy;
+  ps->x[i] += dx;
+  ps->y[i] += dy;
+}
+
+void update_particles(Particles *ps, Rng *rng, int showing_time) {
+  turn_blink_wheel(ps, rng, showing_time);
+  for(int i=0; i<NUM_PARTICLES; i++) {
+    jitter_and_resize(ps, rng, i, showing_time);
+  }
+  for(int i=0; i<NUM_PARTICLES; i++) {
+    move_particle(ps, i);
+  }
+}
+
+// Without jitter or the speed limit, one step of update_particles() moves a
+// particle's offset from its gravity center e and its velocity v by
+//   v' = d (v - e / power),  e' = e + v'
+// (d the damping), a linear map, so `steps` of them are a single 2x2 matrix.
+// The jitter it would have added on the way (a uniform kick of up to JITTER
+// into v, with probability 0.4, before each step) adds up to a zero mean
+// offset whose covariance is summed alongside; advance_particles() draws one
+// with that covariance, from the matrix's Cholesky factor.
+typedef struct SpringSteps
+{
+  int power;
+  int steps;
+  scalar_t a11, a12, a21, a22;
+  scalar_t l11, l21, l22;
+} SpringSteps;
+
+#define SPRING_CACHE_SIZE 16
+// -DCLOSED_FORM_CHUNK=64 makes every catch-up a single closed-form step,
+// for spring-check to compare against
+#ifndef CLOSED_FORM_CHUNK
+#define CLOSED_FORM_CHUNK 6
+#endif
+#define JITTER_VARIANCE (0.4F * JITTER * JITTER / 3.0F)
+#define SQRT_3 1.7320508F
+
+static SpringSteps spring_cache[SPRING_CACHE_SIZE];
+static int spring_cache_next;
+
+// there's no libm on the watch
+static float square_root(float x) {
+  if(x <= 0.0F) return 0.0F;
+  float r = x > 1.0F ? x : 1.0F;
+  for(int k=0; k<32; k++) r = 0.5F * (r + x / r);
+  return r;
+}
+
+// float, since it only runs when a new power or step count shows up
+static const SpringSteps *spring_steps(int power, int steps) {
+  for(int k=0; k<SPRING_CACHE_SIZE; k++) {
+    if(spring_cache[k].steps == steps && spring_cache[k].power == power) return &spring_cache[k];
+  }
+
+  float d = DAMPING, p = (float)power;
+  float m11 = 1.0F - d / p, m12 = d, m21 = -d / p, m22 = d;
+  float a11 = 1.0F, a12 = 0.0F, a21 = 0.0F, a22 = 1.0F; // M^k
+  float c11 = 0.0F, c12 = 0.0F, c22 = 0.0F;
+  for(int k=0; k<steps; k++) {
+    // a kick k steps before the end has been through M^k since its own step
+    float b1 = a11 * d + a12 * d, b2 = a21 * d + a22 * d;
+    c11 += b1 * b1;
+    c12 += b1 * b2;
+    c22 += b2 * b2;
+    float n11 = m11 * a11 + m12 * a21, n12 = m11 * a12 + m12 * a22;
+    float n21 = m21 * a11 + m22 * a21, n22 = m21 * a12 + m22 * a22;
+    a11 = n11; a12 = n12; a21 = n21; a22 = n22;
+  }
+  float l11 = square_root(c11 * JITTER_VARIANCE);
+  float l21 = l11 > 0.0F ? c12 * JITTER_VARIANCE / l11 : 0.0F;
+  float l22 = c22 * JITTER_VARIANCE - l21 * l21;
+  l22 = square_root(l22);
+
+  SpringSteps *s = &spring_cache[spring_cache_next];
+  spring_cache_next = (spring_cache_next + 1) % SPRING_CACHE_SIZE;
+  *s = (SpringSteps){ power, steps,
+    scalar_from_float(a11), scalar_from_float(a12), scalar_from_float(a21), scalar_from_float(a22),
+    scalar_from_float(l11), scalar_from_float(l21), scalar_from_float(l22) };
+  return s;
+}
+
+static scalar_t clamp_scalar(scalar_t v, scalar_t limit) {
+  return v > limit ? limit : v < -limit ? -limit : v;
+}
+
+// one axis: offset e and velocity v, both updated
+static void advance_axis(const SpringSteps *s, Rng *rng, scalar_t *e, scalar_t *v, int steps) {
+  scalar_t z1 = random_scalar(rng, SCALAR(-SQRT_3), SCALAR(SQRT_3));
+  scalar_t z2 = random_scalar(rng, SCALAR(-SQRT_3), SCALAR(SQRT_3));
+  scalar_t e0 = *e;
+  scalar_t e1 = scalar_mul(s->a11, e0) + scalar_mul(s->a12, *v) + scalar_mul(s->l11, z1);
+  scalar_t v1 = scalar_mul(s->a21, e0) + scalar_mul(s->a22, *v) + scalar_mul(s->l21, z1) + scalar_mul(s->l22, z2);
+  // the speed limit is the one non-linear part; no step may go faster
+  *v = clamp_scalar(v1, SCALAR(MAX_SPEED));
+  *e = e0 + clamp_scalar(e1 - e0, steps * SCALAR(MAX_SPEED));
+}
+
+// Up to CLOSED_FORM_CHUNK steps of update_particles() for particle i at
+// about the cost of one. Motion is stepped in closed form as above. Sizes
+// take the same number of steps under constant acceleration with one random
+// divisor, and stop inside a pixel of the goal the way the step-by-step
+// spring does. It draws at most 5 random values however many steps it takes.
+static void advance_particle_at_once(Particles *ps, Rng *rng, int i, int showing_time, int steps) {
+  const SpringSteps *s = spring_steps(ps->power[i], steps);
+  scalar_t ex = ps->x[i] - ps->grav_x[i];
+  scalar_t ey = ps->y[i] - ps->grav_y[i];
+  advance_axis(s, rng, &ex, &ps->dx[i], steps);
+  advance_axis(s, rng, &ey, &ps->dy[i], steps);
+  ps->x[i] = ps->grav_x[i] + ex;
+  ps->y[i] = ps->grav_y[i] + ey;
+
+  scalar_t size = ps->size[i];
+  if(blink_ends(ps, i, showing_time)) {
+    ps->goal_size[i] = SCALAR(MIN_SIZE);
+  }
+
+  scalar_t u = size - ps->goal_size[i];
+  if(within_a_pixel(u, SCALAR(0))) {
+    ps->ds[i] = SCALAR(0);
+  } else {
+    scalar_t accel = -u / random_divisor(rng, 1000, 5000);
+    scalar_t ds = ps->ds[i] + accel * steps;
+    scalar_t u1 = u + ps->ds[i] * steps + accel * (steps * (steps + 1) / 2);
+    if(within_a_pixel(u1, SCALAR(0)) || (u1 > 0) != (u > 0)) {
+      // it would have stopped on the first step that got within a pixel,
+      // and sat there for the rest
+      scalar_t speed = ds < 0 ? -ds : ds;
+      scalar_t inside = speed < SCALAR(1) ? SCALAR(1) - speed : SCALAR(0);
+      u1 = u > 0 ? inside : -inside;
+      ds = SCALAR(0);
+    }
+    size = ps->goal_size[i] + u1;
+    ps->ds[i] = ds;
+  }
+  if(size > SCALAR(MAX_SIZE)) size = SCALAR(MAX_SIZE);
+  if(size < SCALAR(MIN_SIZE)) size = SCALAR(MIN_SIZE);
+  ps->size[i] = size;
+}
+
+// The closed form can only apply the speed limit at the end of its steps,
+// and on long runs it matters along the way: the jitter alone adds about
+// sqrt(steps / 30) px/step of speed, so the limit is what holds the spread
+// of a long run down, even for a particle that starts out at rest. Runs
+// longer than CLOSED_FORM_CHUNK therefore go in chunks of that many; the
+// cost is one step's worth per chunk (64 steps take about a third of
+// stepping them one by one). spring-check shows what a single clamp at the
+// end gets wrong: over 64 steps, 12 px of bias in the swarm and twice the
+// spread in formation.
+static void advance_particle(Particles *ps, Rng *rng, int i, int showing_time, int steps) {
+  while(steps > 0) {
+    int chunk = steps < CLOSED_FORM_CHUNK ? steps : CLOSED_FORM_CHUNK;
+    advance_particle_at_once(ps, rng, i, showing_time, chunk);
+    steps -= chunk;
+  }
+}
+
+// Steps update_particles_lod() skipped were steps toward the old center, so
+// they are caught up before it moves; only the swarm leaves particles behind.
+void set_particle_gravity(Particles *ps, Rng *rng, int i, FPoint grav_center, int power) {
+  if(ps->behind[i] > 0) {
+    advance_particle(ps, rng, i, 0, ps->behind[i]);
+    ps->behind[i] = 0;
+  }
+  ps->grav_x[i] = grav_center.x;
+  ps->grav_y[i] = grav_center.y;
+  ps->power[i] = power;
+}
+
+// Particles that update_particles_lod() left behind catch up here too. Blinks
+// due during the steps all start at the beginning of them.
+void advance_particles(Particles *ps, Rng *rng, int showing_time, int steps) {
+  for(int s=0; s<steps; s++) {
+    turn_blink_wheel(ps, rng, showing_time);
+  }
+  for(int i=0; i<NUM_PARTICLES; i++) {
+    advance_particle(ps, rng, i, showing_time, steps + ps->behind[i]);
+    ps->behind[i] = 0;
+  }
+}
+
+// A dark firefly that isn't about to light up can't be seen wherever it
+// drifts to, so in the swarm only one in LOD_GROUPS of them (taking turns by
+// index) is stepped each time, catching up the steps it missed in closed
+// form. Lit and blinking fireflies, and all of them while the time is up,
+// step every time. A firefly whose blink starts while it is behind catches
+// up straight away, so its blink can start up to LOD_GROUPS - 1 steps early.
+void update_particles_lod(Particles *ps, Rng *rng, int showing_time) {
+  turn_blink_wheel(ps, rng, showing_time);
+  int turn = ps->lod_turn;
+  ps->lod_turn = (turn + 1) % LOD_GROUPS;
+  for(int i=0; i<NUM_PARTICLES; i++) {
+    int dark = within_a_pixel(ps->size[i], SCALAR(MIN_SIZE)) && ps->goal_size[i] == SCALAR(MIN_SIZE);
+    if(showing_time == 0 && dark && i % LOD_GROUPS != turn) {
+      ps->behind[i]++;
+    } else if(ps->behind[i] > 0) {
+      advance_particle(ps, rng, i, showing_time, ps->behind[i] + 1);
+      ps->behind[i] = 0;
+    } else {
+      jitter_and_resize(ps, rng, i, showing_time);
+      move_particle(ps, i);
+    }
+  }
+}
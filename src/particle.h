@@ -0,0 +1,63 @@
+#ifndef PARTICLE_H
+#define PARTICLE_H
+
+#include "fixed.h"
+#include "rng.h"
+
+#define NUM_PARTICLES 140
+#define NORMAL_POWER 400
+#define TIGHT_POWER 1
+#define MAX_SPEED 1.0F
+#define JITTER 0.5F
+#define MAX_SIZE 3.0F
+#define MIN_SIZE 0.0F
+#define BLINK_CHANCE 0.0008F
+#define DAMPING 0.999F
+// dark fireflies in the swarm step once every this many steps
+#define LOD_GROUPS 4
+// blink onsets are kept in this many lists, by step
+#define BLINK_WHEEL_SLOTS 256
+
+typedef struct FPoint
+{
+  scalar_t x;
+  scalar_t y;
+} FPoint;
+// from whole pixel coordinates
+#define FPoint(x, y) ((FPoint){scalar_from_int(x), scalar_from_int(y)})
+
+// Particle state, one array per field so each pass of update_particles()
+// streams through only the fields it needs.
+typedef struct Particles
+{
+  scalar_t x[NUM_PARTICLES];
+  scalar_t y[NUM_PARTICLES];
+  scalar_t dx[NUM_PARTICLES];
+  scalar_t dy[NUM_PARTICLES];
+  scalar_t grav_x[NUM_PARTICLES];
+  scalar_t grav_y[NUM_PARTICLES];
+  int16_t power[NUM_PARTICLES];
+  scalar_t size[NUM_PARTICLES];
+  scalar_t goal_size[NUM_PARTICLES];
+  scalar_t ds[NUM_PARTICLES];
+  uint8_t behind[NUM_PARTICLES]; // steps update_particles_lod() skipped
+  uint8_t lod_turn;
+  // the blink wheel: each slot lists (as index + 1, 0 ending the list) the
+  // particles whose next blink onset falls on a step it holds
+  uint32_t step; // steps taken so far
+  uint32_t blink_at[NUM_PARTICLES]; // step of the next onset, 0 if none
+  uint8_t blink_next[NUM_PARTICLES];
+  uint8_t blink_wheel[BLINK_WHEEL_SLOTS];
+} Particles;
+
+scalar_t random_scalar(Rng *rng, scalar_t min, scalar_t max);
+void init_particle(Particles *ps, Rng *rng, int i, FPoint position, FPoint grav_center, int power);
+void set_particle_gravity(Particles *ps, Rng *rng, int i, FPoint grav_center, int power);
+void update_particles(Particles *ps, Rng *rng, int showing_time);
+void advance_particles(Particles *ps, Rng *rng, int showing_time, int steps);
+void update_particles_lod(Particles *ps, Rng *rng, int showing_time);
+// steps until a dark firefly next starts to light up, 0 if one already is
+// lit or lighting up
+uint32_t steps_until_lit(const Particles *ps);
+
+#endif
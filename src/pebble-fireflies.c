@@ -4,8 +4,16 @@
 #include "pebble_app.h"
 #include "pebble_fonts.h"
 #include "xprintf.h"
-#include "tinymt32.h"
-#include "numbers.h"
+#include "rng.h"
+#include "particle.h"
+#include "render.h"
+#include "glyphs.h"
+#include "formation.h"
+#include "profiler.h"
+#include "trace.h"
+#include "event_log.h"
+#include "clock.h"
+#include "scheduler.h"
 
 // defines
 #define MY_UUID { 0x74, 0x19, 0xF2, 0x5C, 0x82, 0x1B, 0x4B, 0xD8, 0x93, 0xD5, 0x98, 0x7E, 0x31, 0x15, 0xA8, 0xB6 }
@@ -15,63 +23,65 @@ PBL_APP_INFO(MY_UUID,
              RESOURCE_ID_IMAGE_MENU_ICON,
              APP_INFO_WATCH_FACE);
 
-#define maximum(a,b) a > b ? a : b
+#define maximum(a,b) ((a) > (b) ? (a) : (b))
 #define minimum(a,b) ((a) < (b) ? (a) : (b))
-#define NUM_PARTICLES 140
-#define COOKIE_ANIMATION_TIMER 1
-#define COOKIE_SWARM_TIMER 2
-#define COOKIE_DISPERSE_TIMER 3
-#define NORMAL_POWER 400.0F
-#define TIGHT_POWER 1.0F
-#define MAX_SPEED 1.0F
+#define STEP_MS 50
+#define MAX_STEPS_PER_FRAME 64
+// from this many steps on a frame takes them all at once in closed form
+#define CLOSED_FORM_STEPS 3
+#define FRAME_MS 50
+#define MAX_FRAME_MS 200
+// how far, root mean square, the visible swarm may move from frame to frame
+#define SWARM_FRAME_PX 2
+#define DISPERSE_MS 12000
+// how late the swarm and disperse events may run, so that while the
+// animation runs they always share a frame's wakeup
+#define EVENT_SLACK_MS MAX_FRAME_MS
 #define SCREEN_MARGIN 0.0F
-#define JITTER 0.5F
-#define MAX_SIZE 3.0F
-#define MIN_SIZE 0.0F
-
-typedef struct FPoint
-{
-  float x;
-  float y;
-} FPoint;
-
-// typedefs
-typedef struct FParticle 
-{
-  FPoint position;
-  FPoint grav_center;
-  float dx;
-  float dy;
-  float power;
-  float size;
-  float goal_size;
-  float ds;
-} FParticle;
-#define FParticle(px, py, gx, gy, power) ((FParticle){{(px), (py)}, {(gx), (gy)}, 0.0F, 0.0F, power, 0.0F, 0.0F, 0.0F})
-#define FPoint(x, y) ((FPoint){(x), (y)})
+#define GLYPH_COLON 10
+#define MAX_TARGET_GROUPS 5
 
 // globals
-FParticle particles[NUM_PARTICLES];
+Particles particles;
 Window window;
 Layer particle_layer;
 TextLayer text_header_layer;
-AppTimerHandle timer_handle;
-tinymt32_t rndstate;
+int frame_ms = FRAME_MS;
+int min_frame_ms = FRAME_MS; // the simulator's -r sets it
+Rng rng;
+uint32_t rng_seed = 4; // the simulator's replay driver sets it from the log
 int showing_time = 0;
-
-static const GBitmap* number_bitmaps[10] = { 
-  &s_0_bitmap, &s_1_bitmap, &s_2_bitmap, 
-  &s_3_bitmap, &s_4_bitmap, &s_5_bitmap,
-  &s_6_bitmap, &s_7_bitmap, &s_8_bitmap, 
-  &s_9_bitmap 
-};
+VisibleParticles visible_particles;
+Target formation_targets[NUM_PARTICLES];
+
+// One digit (or the colon) of the time: formation_targets[start..end) spell
+// out `glyph` at x.
+typedef struct TargetGroup {
+  int glyph;
+  int start;
+  int end;
+  int x;
+} TargetGroup;
+
+// What the particles spell out right now, and which particle flies to each
+// formation target, so the next display_time() only replans the digits that
+// changed. Cleared when the particles disperse.
+TargetGroup shown_groups[MAX_TARGET_GROUPS];
+int shown_group_count = 0;
+uint8_t target_particle[NUM_PARTICLES];
+Target replanned_targets[NUM_PARTICLES];
+GRect last_particle_bounds; // what the previous frame drew, to be erased
+uint32_t last_frame_at; // clock_ms() at the previous frame
+int physics_ahead_ms;   // how far past last_frame_at physics has run
+scalar_t draw_back; // how far back towards the previous step to draw
+// Once the digits have settled the formation is frozen: no more physics or
+// frames until something wakes the animation. The frame drawn as it froze
+// stays in the sprite renderer's bitmap, and any redraw copies it out.
+bool formation_frozen = false;
+bool snapshot_taken = false;
 
 int random_in_range(int min, int max) {
-  return min + (int)(tinymt32_generate_float01(&rndstate) * ((max - min) + 1));
-}
-
-float random_in_rangef(float min, float max) {
-  return min + (float)(tinymt32_generate_float01(&rndstate) * ((max - min)));
+  return rng_range(&rng, min, max);
 }
 
 GPoint random_point_in_screen() {
@@ -84,159 +94,215 @@ GPoint random_point_roughly_in_screen(int margin, int padding) {
                 random_in_range(0-margin+padding, window.layer.frame.size.h+1+margin-padding));
 }
 
-void update_particle(int i) {
-  // 
-  if(tinymt32_generate_float01(&rndstate) < 0.4F) {
-    particles[i].dx += random_in_rangef(-JITTER, JITTER);
-    particles[i].dy += random_in_rangef(-JITTER, JITTER);
+// Physics runs in fixed STEP_MS steps whatever the frame interval: each
+// frame runs as many steps as it takes to reach or pass the clock, and draws
+// the particles interpolated back from the last step to where they were at
+// the frame's time. Several steps at once (a slow frame rate, or catching up
+// after a gap) are taken together by advance_particles(), which costs about
+// one step per 6 of them (CLOSED_FORM_CHUNK); single steps leave most dark
+// fireflies for later (see update_particles_lod()). A stall longer than
+// MAX_STEPS_PER_FRAME steps is dropped rather than caught up.
+int physics_steps_due() {
+  uint32_t now = clock_ms();
+  int owed = (int)(now - last_frame_at) - physics_ahead_ms;
+  last_frame_at = now;
+  if(owed <= 0) {
+    physics_ahead_ms = -owed;
+    return 0;
   }
+  int steps = minimum((owed + STEP_MS - 1) / STEP_MS, MAX_STEPS_PER_FRAME);
+  physics_ahead_ms = maximum(steps * STEP_MS - owed, 0);
+  return steps;
+}
 
-  // gravitate towards goal
-  particles[i].dx += -(particles[i].position.x - particles[i].grav_center.x)/particles[i].power;
-  particles[i].dy += -(particles[i].position.y - particles[i].grav_center.y)/particles[i].power;
-
-  // damping
-  particles[i].dx *= 0.999F;
-  particles[i].dy *= 0.999F;
-
-  // snap to max
-  if(particles[i].dx >  MAX_SPEED) particles[i].dx =  MAX_SPEED;
-  if(particles[i].dx < -MAX_SPEED) particles[i].dx = -MAX_SPEED;
-  if(particles[i].dy >  MAX_SPEED) particles[i].dy =  MAX_SPEED;
-  if(particles[i].dy < -MAX_SPEED) particles[i].dy = -MAX_SPEED;
-
-  particles[i].position.x += particles[i].dx;
-  particles[i].position.y += particles[i].dy;
-
-  // update size
-  // when we're showing the time, don't blink like you normally would
-  if(showing_time == 0) {
-    if((abs(particles[i].size - MIN_SIZE) < 0.001F) && (tinymt32_generate_float01(&rndstate) < 0.0008F)) {
-      particles[i].goal_size = MAX_SIZE;
-    }
-
-    if(abs(particles[i].size - MAX_SIZE) < 0.001F) {
-      particles[i].goal_size = MIN_SIZE;
+// Only the area that changed is invalidated: the particle layer is shrunk to
+// cover where fireflies were lit last frame and where they are lit now, and
+// nothing is redrawn at all while every firefly is dark.
+void animate_particles() {
+  int steps = physics_steps_due();
+  TRACE(TRACE_FRAME_START, steps, 0);
+  PROFILE_BEGIN(PHASE_PHYSICS);
+  rng_refill(&rng);
+  if(steps >= CLOSED_FORM_STEPS) {
+    advance_particles(&particles, &rng, showing_time, steps);
+  } else {
+    for(int s=0;s<steps;s++) {
+      update_particles_lod(&particles, &rng, showing_time);
     }
   }
-
-  particles[i].ds += -(particles[i].size - particles[i].goal_size)/random_in_rangef(1000.0F, 5000.0F);
-  if(abs(particles[i].size - particles[i].goal_size) > 0.01) {
-    particles[i].size += particles[i].ds;
+  draw_back = scalar_from_int(physics_ahead_ms) / STEP_MS;
+  PROFILE_END(PHASE_PHYSICS);
+
+  PROFILE_BEGIN(PHASE_CULL);
+  find_visible_particles(&particles, draw_back, window.layer.frame.size, &visible_particles);
+  PROFILE_END(PHASE_CULL);
+  formation_frozen = showing_time && formation_settled(&particles);
+
+  GRect bounds = visible_particles.bounds;
+  GRect dirty = rect_union(last_particle_bounds, bounds);
+  last_particle_bounds = bounds;
+  if(dirty.size.w > 0 && dirty.size.h > 0) {
+    layer_set_frame(&particle_layer, dirty);
+    layer_mark_dirty(&particle_layer);
   }
-  if(particles[i].size > MAX_SIZE) particles[i].size = MAX_SIZE;
-  if(particles[i].size < MIN_SIZE) particles[i].size = MIN_SIZE;
 }
 
-void draw_particle(GContext* ctx, int i) {
-  graphics_fill_circle(ctx, GPoint((int)particles[i].position.x,
-                                   (int)particles[i].position.y),
-                       particles[i].size);
+#ifdef FIREFLIES_FILL_CIRCLE
+void draw_particle(GContext* ctx, GPoint origin, int k) {
+  graphics_fill_circle(ctx, GPoint(visible_particles.x[k] - origin.x, visible_particles.y[k] - origin.y),
+                       scalar_to_int(particles.size[visible_particles.index[k]]));
 }
+#endif
 
 void update_particles_layer(Layer *me, GContext* ctx) {
-  (void)me;
-  // update debug text layer
-  // static char test_text[100];
-  // unsigned int foo = tinymt32_generate_uint32(&rndstate);
-  // xsprintf( test_text, "rand: %u", random_in_range(0,10));
-  // text_layer_set_text(&text_header_layer, test_text);
-
+  PROFILE_BEGIN(PHASE_DRAW);
+#ifdef FIREFLIES_FILL_CIRCLE
+  // the layer only covers the dirty area, so draw relative to it
+  GPoint origin = me->frame.origin;
   graphics_context_set_fill_color(ctx, GColorWhite);
-  for(int i=0;i<NUM_PARTICLES;i++) {
-    update_particle(i);
-    draw_particle(ctx, i);
+  for(int i=0;i<visible_particles.count;i++) {
+    draw_particle(ctx, origin, i);
   }
+#else
+  if(snapshot_taken) {
+    draw_particle_snapshot(ctx, me->frame);
+  } else {
+    draw_particle_sprites(ctx, &particles, &visible_particles, me->frame);
+    snapshot_taken = formation_frozen;
+  }
+#endif
+  PROFILE_END(PHASE_DRAW);
+}
+
+// The swarm's energy sets its frame interval: as many steps, doubling up to
+// MAX_FRAME_MS, as its visible fireflies take to move SWARM_FRAME_PX. They
+// move most of a pixel every step, jitter and all, so this is usually two.
+static int swarm_frame_ms() {
+  int steps = 1;
+  while(steps * 2 * STEP_MS <= MAX_FRAME_MS &&
+        visible_particles.energy * (steps * 2) * (steps * 2) <= SCALAR(SWARM_FRAME_PX * SWARM_FRAME_PX)) {
+    steps *= 2;
+  }
+  return maximum(steps * STEP_MS, min_frame_ms);
+}
+
+// Adaptive frame rate: while a frame draws exactly what the one before it
+// did (no firefly lit, moved a pixel or changed radius) the frame interval
+// doubles from min_frame_ms, up to MAX_FRAME_MS, and the fixed physics step
+// keeps the swarm moving at the same speed. Otherwise the time is drawn at
+// full rate, and the swarm at the rate its energy allows. While every
+// firefly is dark and none is lighting up, nothing can show until the next
+// blink onset, so the next frame is put off to the end of that step (the
+// swarm event wakes it earlier). Anything that kicks the swarm calls
+// wake_animation() to go back to full rate, which also thaws a frozen
+// formation.
+void schedule_next_frame() {
+  if(formation_frozen) return;
+  if(!visible_particles.changed) {
+    frame_ms = maximum(minimum(frame_ms * 2, MAX_FRAME_MS), min_frame_ms);
+  } else if(showing_time) {
+    frame_ms = min_frame_ms;
+  } else {
+    frame_ms = swarm_frame_ms();
+  }
+  uint32_t dark_steps = steps_until_lit(&particles);
+  if(dark_steps > 0) {
+    dark_steps = minimum(dark_steps, MAX_STEPS_PER_FRAME);
+    frame_ms = maximum(frame_ms, physics_ahead_ms + (int)dark_steps * STEP_MS);
+    schedule_event(EVENT_FRAME, frame_ms, 0);
+  } else {
+    // on a multiple of the interval, so a change of rate never puts frames
+    // between physics steps, and a tick (on the second, where the
+    // simulator's clock starts) finds a frame due then rather than halfway
+    schedule_event(EVENT_FRAME, frame_ms - clock_ms() % frame_ms, 0);
+  }
+}
+
+void wake_animation() {
+  if(formation_frozen) {
+    // the frozen time isn't simulated
+    formation_frozen = false;
+    snapshot_taken = false;
+    last_frame_at = clock_ms();
+    physics_ahead_ms = 0;
+  } else if(frame_ms == min_frame_ms) {
+    return;
+  }
+  frame_ms = min_frame_ms;
+  schedule_event(EVENT_FRAME, frame_ms, 0);
 }
 
 void swarm_to_a_different_location() {
   GPoint new_gravity = random_point_roughly_in_screen(0, 30);
   FPoint new_gravityf = FPoint(new_gravity.x, new_gravity.y);
   for(int i=0;i<NUM_PARTICLES;i++) {
-    particles[i].grav_center = new_gravityf;
+    set_particle_gravity(&particles, &rng, i, new_gravityf, particles.power[i]);
   }
+  wake_animation();
 }
 
 void disperse_particles() {
+  shown_group_count = 0;
   for(int i=0;i<NUM_PARTICLES;i++) {
-    particles[i].power = NORMAL_POWER;
-    particles[i].goal_size = 0.0F;
+    particles.power[i] = NORMAL_POWER;
+    particles.goal_size[i] = SCALAR(0);
   }
   swarm_to_a_different_location();
 }
 
-void handle_timer(AppContextRef ctx, AppTimerHandle handle, uint32_t cookie) {
-  (void)ctx;
-  (void)handle;
-
-  if (cookie == COOKIE_ANIMATION_TIMER) {
-     layer_mark_dirty(&particle_layer);
-     timer_handle = app_timer_send_event(ctx, 50 /* milliseconds */, COOKIE_ANIMATION_TIMER);
-  } else if (cookie == COOKIE_SWARM_TIMER) {
+void handle_event(ScheduledEvent event) {
+  TRACE(TRACE_TIMER, event, 0);
+  if(event != EVENT_FRAME) EVENT_LOG(LOGGED_TIMER, event);
+  if (event == EVENT_FRAME) {
+     animate_particles();
+     schedule_next_frame();
+     TRACE(TRACE_FRAME_END, visible_particles.count, frame_ms);
+     PROFILE_FRAME_END(visible_particles.count);
+  } else if (event == EVENT_SWARM) {
     if(showing_time == 0) {
       swarm_to_a_different_location();
     }
-    app_timer_send_event(ctx, random_in_range(5000,15000) /* milliseconds */, COOKIE_SWARM_TIMER);
-  } else if (cookie == COOKIE_DISPERSE_TIMER) {
+    schedule_event(EVENT_SWARM, random_in_range(5000,15000) /* milliseconds */, EVENT_SLACK_MS);
+  } else if (event == EVENT_DISPERSE) {
     showing_time = 0;
     disperse_particles();
   }
 }
 
+void handle_timer(AppContextRef ctx, AppTimerHandle handle, uint32_t cookie) {
+  (void)ctx;
+
+  if (cookie == SCHEDULER_COOKIE) {
+    scheduler_timer_fired(handle);
+  }
+  EVENT_LOG_WAKEUP();
+}
+
 void layer_update_callback(Layer *me, GContext* ctx) {
   (void)me;
   (void)ctx;
 }
 
+// fills formation_targets[start_idx..end_idx) with points on the digit;
+// display_time() then decides which particle goes to which target
 void swarm_to_digit(int digit, int start_idx, int end_idx, int offset_x, int offset_y) {
   int end = minimum(end_idx, NUM_PARTICLES);
+  const Glyph *glyph = &glyphs[digit];
 
   for(int i=start_idx; i<end; i++) {
-
-    GBitmap bitmap   = *number_bitmaps[digit];
-    const uint8_t *pixels = bitmap.addr;
-
-    // pick a random point in the four image
-    // get the image
-    // pick a random number the length of the array
-    // if the value is zero, pick a differnet number increment until you get there
-    // move to that position
-    int image_length = bitmap.row_size_bytes * bitmap.bounds.size.h - 1;
-    int idx = random_in_range(0, image_length);
-    uint8_t pixel = pixels[idx];
-
-    // guarantee we're on a non-zero byte
-    while(pixel == 0x00) {
-     idx = random_in_range(0, image_length);
-     pixel = pixels[idx];
-    }
-
-    // pick a non-zero bit
-    int bit_pos = (idx * 8);
-    int bit_add = random_in_range(0,7);
-    int tries = 8;
-    while(!(pixel & (1 << bit_add))) {
-      if(tries < 0) break;
-      bit_add = random_in_range(0,7);
-      tries--;
-    }
-    bit_pos += bit_add;
-
-    
-    int row_size_bits = bitmap.row_size_bytes * 8;
-    int pixel_row = bit_pos / row_size_bits;
-    int pixel_col = bit_pos % row_size_bits;
-
-    float scale = 1.0F;
-    GPoint goal = GPoint(scale*pixel_col+offset_x, scale*pixel_row+offset_y); // switch row & col
-
-    particles[i].grav_center = FPoint(goal.x, goal.y);
-    particles[i].power = TIGHT_POWER;
-    particles[i].goal_size = random_in_rangef(2.0F, 3.5F);
+    // the first N points of a glyph are spread evenly over it, whatever N is
+    GlyphPixel pixel = glyph->pixels[(i - start_idx) % glyph->count];
+    formation_targets[i].point = GPoint(pixel.x + offset_x, pixel.y + offset_y);
+    formation_targets[i].size = random_scalar(&rng, SCALAR(2.0F), SCALAR(3.5F));
   }
 
 }
 
+void swarm_to_colon(int idx, int x) {
+  formation_targets[idx] = (Target){ GPoint(x, 69), SCALAR(3.0F) };   // top
+  formation_targets[idx+1] = (Target){ GPoint(x, 89), SCALAR(3.0F) }; // bottom
+}
+
 unsigned short get_display_hour(unsigned short hour) {
   if (clock_is_24h_style()) { return hour; }
   unsigned short display_hour = hour % 12;
@@ -244,9 +310,12 @@ unsigned short get_display_hour(unsigned short hour) {
 }
 
 void display_time(PblTm *tick_time) {
+  PROFILE_BEGIN(PHASE_RETARGET);
   showing_time = 1;
+  wake_animation();
   unsigned short hour = get_display_hour(tick_time->tm_hour);
   int min = tick_time->tm_min;
+  TRACE(TRACE_RETARGET_START, hour * 100 + min, 0);
 
   //int particles_per_group = NUM_PARTICLES / 2;
 
@@ -254,62 +323,85 @@ void display_time(PblTm *tick_time) {
   int hr_digit_ones = hour % 10; 
   int min_digit_tens = min / 10; 
   int min_digit_ones = min % 10; 
-  int w = window.layer.frame.size.w;
-  int h = window.layer.frame.size.h;
 
   // take out 5 particles
   // 2 for colon
   // 3 for floaters
   int save = 5;
 
+  TargetGroup groups[MAX_TARGET_GROUPS];
+  int group_count;
+  int colon = NUM_PARTICLES - save;
   if(hr_digit_tens == 0) {
     int particles_per_group = (NUM_PARTICLES - save)/ 3;
-    swarm_to_digit(hr_digit_ones,                          0, particles_per_group,   25, 60);
-    swarm_to_digit(min_digit_tens,     particles_per_group, particles_per_group*2,   65, 60);
-    swarm_to_digit(min_digit_ones, (particles_per_group*2), NUM_PARTICLES - save,    95, 60);
-
-    // top colon
-    particles[NUM_PARTICLES-2].grav_center = FPoint(57, 69);
-    particles[NUM_PARTICLES-2].power = TIGHT_POWER;
-    particles[NUM_PARTICLES-2].goal_size = 3.0F;
-
-    // bottom colon
-    particles[NUM_PARTICLES-1].grav_center = FPoint(57, 89);
-    particles[NUM_PARTICLES-1].power = TIGHT_POWER;
-    particles[NUM_PARTICLES-1].goal_size = 3.0F;
-
+    groups[0] = (TargetGroup){ hr_digit_ones,                          0, particles_per_group,   25 };
+    groups[1] = (TargetGroup){ min_digit_tens,     particles_per_group, particles_per_group*2,   65 };
+    groups[2] = (TargetGroup){ min_digit_ones, (particles_per_group*2), NUM_PARTICLES - save,    95 };
+    groups[3] = (TargetGroup){ GLYPH_COLON, colon, colon + 2, 57 };
+    group_count = 4;
   } else {
     int particles_per_group = (NUM_PARTICLES - save)/ 4;
-    swarm_to_digit(hr_digit_tens,                          0, particles_per_group,   10, 60);
-    swarm_to_digit(hr_digit_ones,      particles_per_group, particles_per_group*2, 40, 60);
-    swarm_to_digit(min_digit_tens, (particles_per_group*2), particles_per_group*3, 80, 60);
-    swarm_to_digit(min_digit_ones, (particles_per_group*3), NUM_PARTICLES - save,  110, 60);
-
-    // top colon
-    particles[NUM_PARTICLES-2].grav_center = FPoint(68, 69);
-    particles[NUM_PARTICLES-2].power = TIGHT_POWER;
-    particles[NUM_PARTICLES-2].goal_size = 3.0F;
-
-    // bottom colon
-    particles[NUM_PARTICLES-1].grav_center = FPoint(68, 89);
-    particles[NUM_PARTICLES-1].power = TIGHT_POWER;
-    particles[NUM_PARTICLES-1].goal_size = 3.0F;
+    groups[0] = (TargetGroup){ hr_digit_tens,                          0, particles_per_group,   10 };
+    groups[1] = (TargetGroup){ hr_digit_ones,      particles_per_group, particles_per_group*2, 40 };
+    groups[2] = (TargetGroup){ min_digit_tens, (particles_per_group*2), particles_per_group*3, 80 };
+    groups[3] = (TargetGroup){ min_digit_ones, (particles_per_group*3), NUM_PARTICLES - save,  110 };
+    groups[4] = (TargetGroup){ GLYPH_COLON, colon, colon + 2, 68 };
+    group_count = 5;
+  }
+
+  // Everyone but the 3 floaters flies to a target. While the same layout is
+  // still up, the particles on digits that didn't change stay put and only
+  // the ones on changed digits are matched to the new targets; otherwise
+  // they all are, to whichever targets are closest overall.
+  bool same_layout = shown_group_count == group_count;
+  if(!same_layout) {
+    for(int t=0; t<colon + 2; t++) {
+      target_particle[t] = t < colon ? t : t + 3;
+    }
+  }
+  uint8_t members[NUM_PARTICLES];
+  uint8_t replanned[NUM_PARTICLES]; // formation target of each replanned_targets entry
+  int count = 0;
+  for(int g=0; g<group_count; g++) {
+    TargetGroup *group = &groups[g];
+    if(same_layout && shown_groups[g].glyph == group->glyph) continue;
+    if(group->glyph == GLYPH_COLON) {
+      swarm_to_colon(group->start, group->x);
+    } else {
+      swarm_to_digit(group->glyph, group->start, group->end, group->x, 60);
+    }
+    for(int t=group->start; t<group->end; t++) {
+      members[count] = target_particle[t];
+      replanned[count] = t;
+      replanned_targets[count] = formation_targets[t];
+      count++;
+    }
+    shown_groups[g] = *group;
   }
+  shown_group_count = group_count;
 
+  uint8_t assignment[NUM_PARTICLES];
+  assign_targets(&particles, &rng, members, replanned_targets, count, assignment);
+  for(int k=0; k<count; k++) {
+    target_particle[replanned[assignment[k]]] = members[k];
+  }
+  TRACE(TRACE_RETARGET_END, count, 0);
+  PROFILE_END(PHASE_RETARGET);
 }
 
 void kickoff_display_time() {
   PblTm current_time;
   get_time(&current_time);
   display_time(&current_time);
-  // TODO put the disperse timer here
+  // a later tick or press moves the dispersal rather than adding another
+  schedule_event(EVENT_DISPERSE, DISPERSE_MS, EVENT_SLACK_MS);
 }
 
 void handle_tick(AppContextRef ctx, PebbleTickEvent *t) {
-  (void)t;
   (void)ctx;
+  TRACE(TRACE_TICK, t->tick_time->tm_hour, t->tick_time->tm_min);
+  EVENT_LOG(LOGGED_TICK, 0);
   kickoff_display_time();
-  app_timer_send_event(ctx, 12000 /* milliseconds */, COOKIE_DISPERSE_TIMER);
 }
 
 void init_particles() {
@@ -319,18 +411,20 @@ void init_particles() {
     GPoint goal = GPoint(window.layer.frame.size.w/2, window.layer.frame.size.h/2);
 
     // GPoint start = goal;
-    float initial_power = NORMAL_POWER;
-    // float initial_power = 1.0F;
-    particles[i] = FParticle(start.x, start.y, 
-                             goal.x, goal.y, 
-                             initial_power);
-    particles[i].size = particles[i].goal_size = 0.0F;
+    int initial_power = NORMAL_POWER;
+    // int initial_power = TIGHT_POWER;
+    init_particle(&particles, &rng, i,
+                  FPoint(start.x, start.y),
+                  FPoint(goal.x, goal.y),
+                  initial_power);
   }
 }
 
 void back_single_click_handler(ClickRecognizerRef recognizer, Window *window) {
   (void)recognizer;
   (void)window;
+  TRACE(TRACE_CLICK, BUTTON_ID_BACK, 0);
+  EVENT_LOG(LOGGED_CLICK, BUTTON_ID_BACK);
   kickoff_display_time();
 }
 
@@ -342,10 +436,10 @@ void click_config_provider(ClickConfig **config, Window *window) {
 
 
 void handle_init(AppContextRef ctx) {
-  (void)ctx;
-
-  uint32_t seed = 4;
-  tinymt32_init(&rndstate, seed);
+  clock_start();
+  scheduler_init(ctx, handle_event);
+  EVENT_LOG_START(rng_seed);
+  rng_init(&rng, rng_seed);
 
   window_init(&window, "Fireflies");
   window_stack_push(&window, true /* Animated */);
@@ -365,25 +459,35 @@ void handle_init(AppContextRef ctx) {
   text_layer_init(&text_header_layer, window.layer.frame);
   text_layer_set_text_color(&text_header_layer, GColorWhite);
   text_layer_set_background_color(&text_header_layer, GColorClear);
+#ifdef FIREFLIES_PROFILE
+  // the HUD is rewritten every second, so keep it to the lines it needs
+  layer_set_frame(&text_header_layer.layer, GRect(0, 0, 144-0, 6*16));
+#else
   layer_set_frame(&text_header_layer.layer, GRect(0, 0, 144-0, 168-0));
+#endif
   text_layer_set_font(&text_header_layer, fonts_get_system_font(FONT_KEY_GOTHIC_14));
   layer_add_child(&window.layer, &text_header_layer.layer);
+  PROFILE_INIT(&text_header_layer);
+  TRACE_INIT();
  
   layer_init(&particle_layer, GRect(0,0, window.layer.frame.size.w, window.layer.frame.size.h));
   particle_layer.update_proc = update_particles_layer;
   layer_add_child(&window.layer, &particle_layer);
 
-  timer_handle = app_timer_send_event(ctx, 50 /* milliseconds */, COOKIE_ANIMATION_TIMER);
-  app_timer_send_event(ctx, random_in_range(5000,15000) /* milliseconds */, COOKIE_SWARM_TIMER);
+  last_frame_at = clock_ms();
+  schedule_event(EVENT_FRAME, min_frame_ms, 0);
+  schedule_event(EVENT_SWARM, random_in_range(5000,15000) /* milliseconds */, EVENT_SLACK_MS);
 }
 
 void handle_deinit(AppContextRef ctx) {
 	(void)ctx;
+	EVENT_LOG(LOGGED_END, 0);
 }
 
 void pbl_main(void *params) {
   PebbleAppHandlers handlers = {
     .init_handler = &handle_init,
+    .deinit_handler = &handle_deinit,
     .timer_handler = &handle_timer,
 
     // Handle time updates
@@ -0,0 +1,74 @@
+#ifdef FIREFLIES_PROFILE
+
+#include "pebble_os.h"
+#include "xprintf.h"
+#include "profiler.h"
+#include "cycles.h"
+
+static const char *phase_names[NUM_PHASES] = { "phys", "cull", "draw", "retg" };
+
+static uint32_t samples[NUM_PHASES][PROFILE_WINDOW];
+static uint8_t sample_count[NUM_PHASES];
+static uint8_t next_sample[NUM_PHASES];
+
+static TextLayer *hud_layer;
+static char hud_text[128];
+static int frames_this_second;
+static int last_second = -1;
+
+void profiler_init(TextLayer *hud) {
+  hud_layer = hud;
+  cycles_start();
+}
+
+void profiler_record(ProfilePhase phase, uint32_t ticks) {
+  samples[phase][next_sample[phase]] = ticks;
+  next_sample[phase] = (next_sample[phase] + 1) % PROFILE_WINDOW;
+  if(sample_count[phase] < PROFILE_WINDOW) sample_count[phase]++;
+}
+
+static char *format_phase(char *out, ProfilePhase phase) {
+  int n = sample_count[phase];
+  if(n == 0) {
+    xsprintf(out, "%s -\n", phase_names[phase]);
+  } else {
+    uint32_t lo = 0xFFFFFFFF, hi = 0, sum = 0;
+    for(int i=0;i<n;i++) {
+      uint32_t s = samples[phase][i];
+      if(s < lo) lo = s;
+      if(s > hi) hi = s;
+      sum += s;
+    }
+    xsprintf(out, "%s %lu/%lu/%lu us\n", phase_names[phase],
+             (unsigned long)(lo / CYCLES_PER_US),
+             (unsigned long)(sum / n / CYCLES_PER_US),
+             (unsigned long)(hi / CYCLES_PER_US));
+  }
+  while(*out) out++;
+  return out;
+}
+
+// the HUD is rewritten when the watch's clock ticks over to a new second, so
+// fps is simply the number of frames that fit in the second that just ended
+void profiler_frame_end(int active_particles) {
+  PblTm now;
+  get_time(&now);
+  if(now.tm_sec == last_second) {
+    frames_this_second++;
+    return;
+  }
+
+  int fps = last_second < 0 ? 0 : frames_this_second;
+  last_second = now.tm_sec;
+  frames_this_second = 1;
+
+  char *out = hud_text;
+  xsprintf(out, "%d fps, %d lit\n", fps, active_particles);
+  while(*out) out++;
+  for(int p=0;p<NUM_PHASES;p++) {
+    out = format_phase(out, p);
+  }
+  if(hud_layer) text_layer_set_text(hud_layer, hud_text);
+}
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "pebble_os.h"
+#include "cycles.h"
+
+// Per-phase frame profiler, built only with -DFIREFLIES_PROFILE (make
+// PROFILE=1). Each phase keeps its last PROFILE_WINDOW samples in a ring
+// buffer; about once a second profiler_frame_end() writes fps, min/avg/max
+// microseconds per phase and the number of lit fireflies into a text layer.
+// Without the flag every macro below expands to nothing.
+
+typedef enum {
+  PHASE_PHYSICS,
+  PHASE_CULL,
+  PHASE_DRAW,
+  PHASE_RETARGET,
+  NUM_PHASES
+} ProfilePhase;
+
+#ifdef FIREFLIES_PROFILE
+
+#define PROFILE_WINDOW 32
+
+void profiler_init(TextLayer *hud);
+void profiler_record(ProfilePhase phase, uint32_t ticks);
+void profiler_frame_end(int active_particles);
+
+#define PROFILE_INIT(hud) profiler_init(hud)
+#define PROFILE_BEGIN(phase) uint32_t profile_start_##phase = cycles_now()
+#define PROFILE_END(phase) profiler_record(phase, cycles_now() - profile_start_##phase)
+#define PROFILE_FRAME_END(active) profiler_frame_end(active)
+
+#else
+
+#define PROFILE_INIT(hud) ((void)0)
+#define PROFILE_BEGIN(phase) ((void)0)
+#define PROFILE_END(phase) ((void)0)
+#define PROFILE_FRAME_END(active) ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,152 @@
+#include "render.h"
+
+#define minimum(a,b) ((a) < (b) ? (a) : (b))
+#define maximum(a,b) ((a) > (b) ? (a) : (b))
+
+RenderStats render_stats;
+
+// Filled circles for every radius a firefly is drawn at, one bit mask per
+// row (bit 0 is the leftmost pixel, x - r). These are the pixels
+// graphics_fill_circle() fills: those with dx^2 + dy^2 <= r^2 + r.
+#define MAX_SPRITE_RADIUS 3
+static const uint8_t sprite_rows[MAX_SPRITE_RADIUS + 1][2 * MAX_SPRITE_RADIUS + 1] = {
+  { 0 },
+  { 0x07, 0x07, 0x07 },
+  { 0x0e, 0x1f, 0x1f, 0x1f, 0x0e },
+  { 0x1c, 0x3e, 0x7f, 0x7f, 0x7f, 0x3e, 0x1c },
+};
+
+static uint32_t frame_words[FRAME_HEIGHT][FRAME_ROW_WORDS];
+static GBitmap frame_bitmap = {
+  .addr = frame_words,
+  .row_size_bytes = FRAME_ROW_WORDS * 4,
+  .info_flags = 0x1000,
+  .bounds = { { 0, 0 }, { FRAME_WIDTH, FRAME_HEIGHT } },
+};
+
+GRect rect_union(GRect a, GRect b) {
+  if(a.size.w <= 0 || a.size.h <= 0) return b;
+  if(b.size.w <= 0 || b.size.h <= 0) return a;
+  int x0 = minimum(a.origin.x, b.origin.x);
+  int y0 = minimum(a.origin.y, b.origin.y);
+  int x1 = maximum(a.origin.x + a.size.w, b.origin.x + b.size.w);
+  int y1 = maximum(a.origin.y + a.size.h, b.origin.y + b.size.h);
+  return GRect(x0, y0, x1 - x0, y1 - y0);
+}
+
+// Dark fireflies (radius 0 draws nothing) and ones that have drifted wholly
+// off screen never reach the graphics API; the rest are listed, and their
+// bounding box (clipped to the screen) recorded. When physics has run ahead
+// of the clock, particles are drawn `back` of the way towards where they
+// were before the last step, which is their last step's velocity behind.
+void find_visible_particles(const Particles *ps, scalar_t back, GSize screen, VisibleParticles *visible) {
+  int x0 = screen.w, y0 = screen.h, x1 = 0, y1 = 0;
+  int count = 0;
+  bool changed = false;
+  scalar_t energy = SCALAR(0);
+  uint32_t dark = 0, offscreen = 0;
+
+  for(int i=0;i<NUM_PARTICLES;i++) {
+    int r = scalar_to_int(ps->size[i]);
+    if(r <= 0) {
+      dark++;
+      continue;
+    }
+    scalar_t fx = ps->x[i];
+    scalar_t fy = ps->y[i];
+    if(back != SCALAR(0)) {
+      fx -= scalar_mul(ps->dx[i], back);
+      fy -= scalar_mul(ps->dy[i], back);
+    }
+    int x = scalar_to_int(fx);
+    int y = scalar_to_int(fy);
+    if(x + r < 0 || y + r < 0 || x - r >= screen.w || y - r >= screen.h) {
+      offscreen++;
+      continue;
+    }
+    if(count >= visible->count || visible->index[count] != i || visible->x[count] != x ||
+       visible->y[count] != y || visible->radius[count] != r) {
+      changed = true;
+      visible->index[count] = i;
+      visible->x[count] = x;
+      visible->y[count] = y;
+      visible->radius[count] = r;
+    }
+    energy += scalar_mul(ps->dx[i], ps->dx[i]) + scalar_mul(ps->dy[i], ps->dy[i]) +
+              scalar_mul(ps->ds[i], ps->ds[i]);
+    count++;
+    x0 = minimum(x0, x - r);
+    y0 = minimum(y0, y - r);
+    x1 = maximum(x1, x + r + 1);
+    y1 = maximum(y1, y + r + 1);
+  }
+
+  visible->changed = changed || count != visible->count;
+  visible->count = count;
+  if(count == 0) {
+    visible->bounds = GRect(0, 0, 0, 0);
+    visible->energy = SCALAR(0);
+  } else {
+    visible->energy = energy / count;
+    x0 = maximum(x0, 0);
+    y0 = maximum(y0, 0);
+    x1 = minimum(x1, screen.w);
+    y1 = minimum(y1, screen.h);
+    visible->bounds = GRect(x0, y0, x1 - x0, y1 - y0);
+  }
+
+  render_stats.frames++;
+  render_stats.drawn += count;
+  render_stats.culled_dark += dark;
+  render_stats.culled_offscreen += offscreen;
+}
+
+// ORs one sprite into the frame a row at a time, each row a shifted mask
+// written into (at most) two words
+static void stamp_sprite(int x, int y, int r) {
+  const uint8_t *rows = sprite_rows[r];
+  int left = x - r;
+  int shift_right = 0;
+  if(left < 0) {
+    shift_right = -left;
+    left = 0;
+  }
+  int word = left >> 5;
+  int bit = left & 31;
+
+  for(int row=0; row<=2*r; row++) {
+    int py = y - r + row;
+    if(py < 0 || py >= FRAME_HEIGHT) continue;
+    uint64_t mask = (uint64_t)(rows[row] >> shift_right) << bit;
+    frame_words[py][word] |= (uint32_t)mask;
+    if(word + 1 < FRAME_ROW_WORDS) frame_words[py][word + 1] |= (uint32_t)(mask >> 32);
+  }
+}
+
+// Clears `area` (in screen coordinates) of the frame, stamps every visible
+// particle into it, and copies it to the layer in one bitmap draw. Only the
+// lit pixels are copied, so whatever is under the layer stays visible.
+void draw_particle_sprites(GContext *ctx, const Particles *ps, const VisibleParticles *visible, GRect area) {
+  int first_word = area.origin.x >> 5;
+  int last_word = (area.origin.x + area.size.w - 1) >> 5;
+  for(int y=area.origin.y; y<area.origin.y+area.size.h; y++) {
+    for(int w=first_word; w<=last_word; w++) frame_words[y][w] = 0;
+  }
+
+  for(int k=0; k<visible->count; k++) {
+    int i = visible->index[k];
+    int r = minimum(scalar_to_int(ps->size[i]), MAX_SPRITE_RADIUS);
+    stamp_sprite(visible->x[k], visible->y[k], r);
+  }
+
+  draw_particle_snapshot(ctx, area);
+}
+
+// Copies `area` of the frame out as the last draw_particle_sprites() left it,
+// so a formation that has stopped moving can be redrawn without stamping it
+// again.
+void draw_particle_snapshot(GContext *ctx, GRect area) {
+  frame_bitmap.bounds = area;
+  graphics_context_set_compositing_mode(ctx, GCompOpOr);
+  graphics_draw_bitmap_in_rect(ctx, &frame_bitmap, GRect(0, 0, area.size.w, area.size.h));
+}
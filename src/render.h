@@ -0,0 +1,46 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include "pebble_os.h"
+#include "particle.h"
+
+// Particles that will draw at least one on-screen pixel this frame, in draw
+// order with the pixel each is drawn at and its radius, the box they cover
+// and whether any of that differs from the frame before (the list is kept
+// from frame to frame and compared as it is rewritten). Their energy is the
+// mean of dx^2 + dy^2 + ds^2, how far they move and resize in a step, squared.
+typedef struct VisibleParticles
+{
+  uint8_t index[NUM_PARTICLES];
+  int16_t x[NUM_PARTICLES];
+  int16_t y[NUM_PARTICLES];
+  int8_t radius[NUM_PARTICLES];
+  int count;
+  GRect bounds;
+  bool changed;
+  scalar_t energy;
+} VisibleParticles;
+
+// Running totals since startup, for the simulator and debug builds.
+typedef struct RenderStats
+{
+  uint32_t frames;
+  uint32_t drawn;
+  uint32_t culled_dark;      // radius below one pixel
+  uint32_t culled_offscreen; // entirely outside the screen
+} RenderStats;
+
+extern RenderStats render_stats;
+
+// The sprite renderer draws into its own 1bpp frame the size of the screen,
+// laid out like the watch's framebuffer (least significant bit leftmost).
+#define FRAME_WIDTH 144
+#define FRAME_HEIGHT 168
+#define FRAME_ROW_WORDS 5
+
+GRect rect_union(GRect a, GRect b);
+void find_visible_particles(const Particles *ps, scalar_t back, GSize screen, VisibleParticles *visible);
+void draw_particle_sprites(GContext *ctx, const Particles *ps, const VisibleParticles *visible, GRect area);
+void draw_particle_snapshot(GContext *ctx, GRect area);
+
+#endif
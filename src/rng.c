@@ -0,0 +1,36 @@
+#include "rng.h"
+
+void rng_init(Rng *rng, uint32_t seed) {
+#ifdef FIREFLIES_TINYMT_RNG
+  tinymt32_init(&rng->mt, seed);
+#else
+  // any non-zero state works; spread small seeds over all the bits
+  rng->state = seed * 2654435761U;
+  if(rng->state == 0) rng->state = 1;
+#endif
+  rng->next = RNG_BUFFER_SIZE;
+  rng->generated = 0;
+  rng_refill(rng);
+}
+
+// Replaces the values handed out since the last refill. The ones not yet
+// used stay where they are, so nothing is wasted.
+void rng_refill(Rng *rng) {
+  uint16_t used = rng->next;
+#ifdef FIREFLIES_TINYMT_RNG
+  for(int i=0; i<used; i++) {
+    rng->values[i] = tinymt32_generate_uint32(&rng->mt);
+  }
+#else
+  uint32_t x = rng->state;
+  for(int i=0; i<used; i++) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rng->values[i] = x;
+  }
+  rng->state = x;
+#endif
+  rng->next = 0;
+  rng->generated += used;
+}
@@ -0,0 +1,44 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+#include "tinymt32.h"
+
+// Random numbers are generated in batches: rng_refill() tops the buffer up in
+// one tight loop (once per frame), and the particle loop just reads the next
+// raw 32-bit value out of it. It is filled from xorshift32, which is plenty
+// random enough for fireflies; build with -DFIREFLIES_TINYMT_RNG to fill it
+// from tinymt32 instead, which costs more per value than drawing from it
+// directly saves (make bench-rng).
+
+#define RNG_BUFFER_SIZE 256
+
+typedef struct Rng
+{
+  uint32_t values[RNG_BUFFER_SIZE];
+  uint16_t next; // values before this have been handed out
+  uint32_t generated;
+#ifdef FIREFLIES_TINYMT_RNG
+  tinymt32_t mt;
+#else
+  uint32_t state;
+#endif
+} Rng;
+
+void rng_init(Rng *rng, uint32_t seed);
+void rng_refill(Rng *rng);
+
+static inline uint32_t rng_next(Rng *rng) {
+  if(rng->next == RNG_BUFFER_SIZE) rng_refill(rng);
+  return rng->values[rng->next++];
+}
+
+// true with probability p, which should be a constant
+#define rng_chance(rng, p) (rng_next(rng) < (uint32_t)((p) * 4294967296.0))
+
+// uniform in [min, max]
+static inline int rng_range(Rng *rng, int min, int max) {
+  return min + (int)(((uint64_t)rng_next(rng) * (uint32_t)(max - min + 1)) >> 32);
+}
+
+#endif
@@ -0,0 +1,102 @@
+#include "clock.h"
+#include "scheduler.h"
+
+typedef struct {
+  uint8_t event;
+  uint32_t deadline_ms;
+  uint32_t slack_ms;
+} PendingEvent;
+
+static AppContextRef app_ctx;
+static ScheduledEventHandler event_handler;
+static PendingEvent queue[NUM_SCHEDULED_EVENTS]; // earliest deadline first
+static int queued;
+static AppTimerHandle timer;
+static bool armed;
+static uint32_t armed_ms;
+static bool dispatching;
+
+// clock_ms() wraps, so times are only ever compared through differences
+static bool before(uint32_t a, uint32_t b) {
+  return (int32_t)(a - b) < 0;
+}
+
+static void unqueue(int k) {
+  for(; k<queued-1; k++) queue[k] = queue[k+1];
+  queued--;
+}
+
+static int find(ScheduledEvent event) {
+  for(int k=0; k<queued; k++) {
+    if(queue[k].event == event) return k;
+  }
+  return -1;
+}
+
+// arms the app timer for the earliest point where some event's slack runs
+// out, leaving it alone if it is already set for then
+static void arm(uint32_t now) {
+  if(dispatching) return;
+  if(queued == 0) {
+    if(armed) app_timer_cancel_event(app_ctx, timer);
+    armed = false;
+    return;
+  }
+  uint32_t wake = queue[0].deadline_ms + queue[0].slack_ms;
+  for(int k=1; k<queued; k++) {
+    uint32_t latest = queue[k].deadline_ms + queue[k].slack_ms;
+    if(before(latest, wake)) wake = latest;
+  }
+  if(armed && armed_ms == wake) return;
+  if(armed) app_timer_cancel_event(app_ctx, timer);
+  timer = app_timer_send_event(app_ctx, before(now, wake) ? wake - now : 0, SCHEDULER_COOKIE);
+  armed = true;
+  armed_ms = wake;
+}
+
+void scheduler_init(AppContextRef ctx, ScheduledEventHandler handler) {
+  app_ctx = ctx;
+  event_handler = handler;
+  queued = 0;
+  armed = false;
+}
+
+void schedule_event(ScheduledEvent event, uint32_t delay_ms, uint32_t slack_ms) {
+  uint32_t now = clock_ms();
+  int k = find(event);
+  if(k >= 0) unqueue(k);
+
+  PendingEvent pending = { event, now + delay_ms, slack_ms };
+  // after any equal deadline, so events due together run in the order they
+  // were scheduled
+  for(k=queued; k>0 && before(pending.deadline_ms, queue[k-1].deadline_ms); k--) {
+    queue[k] = queue[k-1];
+  }
+  queue[k] = pending;
+  queued++;
+  arm(now);
+}
+
+void cancel_event(ScheduledEvent event) {
+  int k = find(event);
+  if(k < 0) return;
+  unqueue(k);
+  arm(clock_ms());
+}
+
+void scheduler_timer_fired(AppTimerHandle handle) {
+  // a timer that was cancelled after it had already been delivered
+  if(!armed || handle != timer) return;
+  armed = false;
+  clock_advance_to(armed_ms);
+
+  uint32_t now = clock_ms();
+  dispatching = true;
+  while(queued > 0 && !before(now, queue[0].deadline_ms)) {
+    ScheduledEvent event = queue[0].event;
+    unqueue(0);
+    event_handler(event);
+  }
+  dispatching = false;
+  arm(clock_ms());
+}
@@ -0,0 +1,32 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "pebble_os.h"
+#include "pebble_app.h"
+
+// Every timed event of the watch face goes through one app timer. Pending
+// events sit in a queue ordered by deadline, each kind at most once:
+// scheduling a kind that is already pending moves it, so a superseded frame
+// or disperse is cancelled rather than left to fire. The app timer is armed
+// only for the earliest time something has to run, and every event that is
+// due by then runs on that wakeup. An event's slack is how late it may run
+// to share a wakeup, so slow events ride along with the next frame.
+
+typedef enum {
+  EVENT_FRAME,
+  EVENT_SWARM,
+  EVENT_DISPERSE,
+  NUM_SCHEDULED_EVENTS
+} ScheduledEvent;
+
+#define SCHEDULER_COOKIE 1
+
+typedef void (*ScheduledEventHandler)(ScheduledEvent event);
+
+void scheduler_init(AppContextRef ctx, ScheduledEventHandler handler);
+void schedule_event(ScheduledEvent event, uint32_t delay_ms, uint32_t slack_ms);
+void cancel_event(ScheduledEvent event);
+// for the app's timer handler: runs whatever is due
+void scheduler_timer_fired(AppTimerHandle handle);
+
+#endif
@@ -0,0 +1,11 @@
+#ifdef FIREFLIES_TRACE
+
+#include "trace.h"
+
+TraceBuffer trace_buffer = {
+  .magic = TRACE_MAGIC,
+  .cycles_per_us = CYCLES_PER_US,
+  .capacity = TRACE_RECORDS,
+};
+
+#endif
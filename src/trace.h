@@ -0,0 +1,72 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include "clock.h"
+#include "cycles.h"
+
+// Binary event trace, built only with -DFIREFLIES_TRACE (make TRACE=1).
+// Each TRACE() stores one fixed-size record in a static ring buffer and does
+// no formatting at all, so it is cheap enough for the animation path. The
+// buffer carries its own header; dump `trace_buffer` from the watch's RAM (or
+// run the simulator with -T) and decode it offline with `make trace-decode`.
+//
+// Records are placed on the timeline by clock_ms(), which counts time spent
+// asleep. The DWT cycle counter stops while the core sleeps, so the cycle
+// stamp is only good for how long the watch was awake between two records.
+
+typedef enum {
+  TRACE_FRAME_START = 1, // arg0: physics steps
+  TRACE_FRAME_END,       // arg0: lit fireflies, arg1: next frame interval in ms
+  TRACE_TIMER,           // arg0: ScheduledEvent run
+  TRACE_TICK,            // arg0: hour, arg1: minute
+  TRACE_CLICK,           // arg0: button
+  TRACE_RETARGET_START,  // arg0: time being shown as hhmm
+  TRACE_RETARGET_END,    // arg0: particles assigned
+  NUM_TRACE_EVENTS
+} TraceEvent;
+
+typedef struct {
+  uint32_t ms;     // clock_ms()
+  uint32_t cycles; // cycles_now()
+  uint16_t event;
+  uint16_t arg0;
+  uint32_t arg1;
+} TraceRecord;
+
+// must be a power of two
+#define TRACE_RECORDS 128
+#define TRACE_MAGIC 0x32544646 // "FFT2"
+
+typedef struct {
+  uint32_t magic;
+  uint32_t cycles_per_us;
+  uint32_t written;   // records ever written; the oldest is at written % TRACE_RECORDS once it wraps
+  uint32_t capacity;
+  TraceRecord records[TRACE_RECORDS];
+} TraceBuffer;
+
+#ifdef FIREFLIES_TRACE
+
+extern TraceBuffer trace_buffer;
+
+static inline void trace_event(TraceEvent event, uint16_t arg0, uint32_t arg1) {
+  TraceRecord *r = &trace_buffer.records[trace_buffer.written++ & (TRACE_RECORDS - 1)];
+  r->ms = clock_ms();
+  r->cycles = cycles_now();
+  r->event = event;
+  r->arg0 = arg0;
+  r->arg1 = arg1;
+}
+
+#define TRACE_INIT() cycles_start()
+#define TRACE(event, arg0, arg1) trace_event((event), (arg0), (arg1))
+
+#else
+
+#define TRACE_INIT() ((void)0)
+#define TRACE(event, arg0, arg1) ((void)0)
+
+#endif
+
+#endif